@@ -1100,7 +1100,7 @@ void AdvanceButtonDialog::populateSetSelectionComboBox()
             temp.append(tr("Select Set %1").arg(i+1));
 
             InputDevice *tempdevice = button->getParentSet()->getInputDevice();
-            SetJoystick *tempset = tempdevice->getSetJoystick(i);
+            SetJoystick *tempset = tempdevice->findSetJoystick(i);
             if (tempset)
             {
                 QString setName = tempset->getName();
@@ -1144,7 +1144,7 @@ void AdvanceButtonDialog::populateSlotSetSelectionComboBox()
             temp.append(tr("Select Set %1").arg(i+1));
 
             InputDevice *tempdevice = button->getParentSet()->getInputDevice();
-            SetJoystick *tempset = tempdevice->getSetJoystick(i);
+            SetJoystick *tempset = tempdevice->findSetJoystick(i);
             if (tempset)
             {
                 QString setName = tempset->getName();
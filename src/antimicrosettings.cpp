@@ -52,4 +52,15 @@ void AntiMicroSettings::importFromCommandLine(CommandLineUtility &cmdutility)
     {
         cmdSettings.setValue("DisplaySDLMapping", 1);
     }
+    if (cmdutility.isInputThreadRequested())
+    {
+        cmdSettings.setValue("Input/DrainOnThread", 1);
+    }
+#ifdef WITH_EVDEV
+    // Replayed input is pushed into the SDL event queue.
+    if (cmdutility.isEvdevInputRequested() && !cmdutility.hasReplayInputLocation())
+    {
+        cmdSettings.setValue("Input/Evdev", 1);
+    }
+#endif
 }
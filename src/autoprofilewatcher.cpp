@@ -11,12 +11,15 @@
 
 #if defined(Q_OS_UNIX) && defined(WITH_X11)
 #include "x11extras.h"
+#include "x11focuswatcher.h"
 
 #elif defined(Q_OS_WIN)
 #include "winextras.h"
 
 #endif
 
+const QString AutoProfileWatcher::REGEXPREFIX = QString("regex:");
+
 AutoProfileWatcher::AutoProfileWatcher(AntiMicroSettings *settings, QObject *parent) :
     QObject(parent)
 {
@@ -27,16 +30,43 @@ AutoProfileWatcher::AutoProfileWatcher(AntiMicroSettings *settings, QObject *par
     syncProfileAssignment();
 
     connect(&appTimer, SIGNAL(timeout()), this, SLOT(runAppCheck()));
+
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+    focusWatcher = new X11FocusWatcher(this);
+    connect(focusWatcher, SIGNAL(activeWindowChanged()), this, SLOT(runAppCheck()));
+#endif
 }
 
+/**
+ * @brief Start checking the application in focus. On X11 the check runs
+ *     when the window manager reports a new active window or, if a profile
+ *     is assigned by window title, a title change. The timer is only used
+ *     when those events are not available.
+ */
 void AutoProfileWatcher::startTimer()
 {
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+    if (focusWatcher->start(!windowNameProfileAssignments.isEmpty()))
+    {
+        appTimer.stop();
+        runAppCheck();
+    }
+    else
+    {
+        appTimer.start(CHECKTIME);
+    }
+#else
     appTimer.start(CHECKTIME);
+#endif
 }
 
 void AutoProfileWatcher::stopTimer()
 {
     appTimer.stop();
+
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+    focusWatcher->stop();
+#endif
 }
 
 void AutoProfileWatcher::runAppCheck()
@@ -111,71 +141,56 @@ void AutoProfileWatcher::runAppCheck()
         currentAppWindowTitle = nowWindowName;
         //currentApplication = appLocation;
 
-        QSet<AutoProfileInfo*> fullSet;
+        // Rules are checked straight from the assignment lists. A rule found
+        // through more than one list is checked again with the same result.
+        QHash<QString, int> highestMatchScore;
+        QHash<QString, AutoProfileInfo*> highestMatches;
 
+        QList<AutoProfileInfo*> candidates;
         if (!appLocation.isEmpty() && appProfileAssignments.contains(appLocation))
         {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = appProfileAssignments.value(appLocation).toSet();
-            fullSet.unite(tempSet);
+            candidates = appProfileAssignments.value(appLocation);
         }
         else if (!baseAppFileName.isEmpty() && appProfileAssignments.contains(baseAppFileName))
         {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = appProfileAssignments.value(baseAppFileName).toSet();
-            fullSet.unite(tempSet);
+            candidates = appProfileAssignments.value(baseAppFileName);
+        }
+
+        for (int i=0; i < candidates.size(); i++)
+        {
+            checkProfileMatch(candidates.at(i), appLocation, nowWindowClass, nowWindowName,
+                              highestMatchScore, highestMatches);
         }
 
         if (!nowWindowClass.isEmpty() && windowClassProfileAssignments.contains(nowWindowClass))
         {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = windowClassProfileAssignments.value(nowWindowClass).toSet();
-            fullSet.unite(tempSet);
+            candidates = windowClassProfileAssignments.value(nowWindowClass);
+            for (int i=0; i < candidates.size(); i++)
+            {
+                checkProfileMatch(candidates.at(i), appLocation, nowWindowClass, nowWindowName,
+                                  highestMatchScore, highestMatches);
+            }
         }
 
         if (!nowWindowName.isEmpty() && windowNameProfileAssignments.contains(nowWindowName))
         {
-            QSet<AutoProfileInfo*> tempSet;
-            tempSet = windowNameProfileAssignments.value(nowWindowName).toSet();
-            fullSet = fullSet.unite(tempSet);
+            candidates = windowNameProfileAssignments.value(nowWindowName);
+            for (int i=0; i < candidates.size(); i++)
+            {
+                checkProfileMatch(candidates.at(i), appLocation, nowWindowClass, nowWindowName,
+                                  highestMatchScore, highestMatches);
+            }
         }
 
-        QHash<QString, int> highestMatchCount;
-        QHash<QString, AutoProfileInfo*> highestMatches;
-
-        QSetIterator<AutoProfileInfo*> fullSetIter(fullSet);
-        while (fullSetIter.hasNext())
+        if (!nowWindowName.isEmpty())
         {
-            AutoProfileInfo *info = fullSetIter.next();
-            if (info->isActive())
+            // Walk the pattern rules in rule order so the first of several
+            // equally good rules always wins.
+            QListIterator<AutoProfileInfo*> patternIter(windowNamePatternRules);
+            while (patternIter.hasNext())
             {
-                int numProps = 0;
-                numProps += !info->getExe().isEmpty() ? 1 : 0;
-                numProps += !info->getWindowClass().isEmpty() ? 1 : 0;
-                numProps += !info->getWindowName().isEmpty() ? 1 : 0;
-
-                int numMatched = 0;
-                numMatched += info->getExe() == appLocation ? 1 : 0;
-                numMatched += info->getWindowClass() == nowWindowClass ? 1 : 0;
-                numMatched += info->getWindowName() == nowWindowName ? 1 : 0;
-
-                if (numProps == numMatched)
-                {
-                    if (highestMatchCount.contains(info->getGUID()))
-                    {
-                        int currentHigh = highestMatchCount.value(info->getGUID());
-                        if (numMatched > currentHigh)
-                        {
-                            highestMatchCount.insert(info->getGUID(), numMatched);
-                            highestMatches.insert(info->getGUID(), info);
-                        }
-                    }
-                    else
-                    {
-                        highestMatchCount.insert(info->getGUID(), numMatched);
-                        highestMatches.insert(info->getGUID(), info);
-                    }
-                }
+                checkProfileMatch(patternIter.next(), appLocation, nowWindowClass, nowWindowName,
+                                  highestMatchScore, highestMatches);
             }
         }
 
@@ -212,6 +227,110 @@ void AutoProfileWatcher::runAppCheck()
     }
 }
 
+/**
+ * @brief Build the compiled pattern of a title rule. Titles that start with
+ *     REGEXPREFIX are regular expressions that may match any part of the
+ *     window title. Titles containing * or ? are wildcards for the whole
+ *     title. A backslash before * or ? keeps the character literal. Other
+ *     titles only match exactly.
+ * @param Title of the rule
+ * @param Pattern that will be filled in
+ * @return Whether the title is a valid pattern
+ */
+bool AutoProfileWatcher::buildWindowNamePattern(QString windowName, QRegExp &pattern)
+{
+    bool result = false;
+
+    bool hasWildcard = false;
+    for (int i=0; i < windowName.length() && !hasWildcard; i++)
+    {
+        QChar current = windowName.at(i);
+        if (current == QChar('\\'))
+        {
+            // Skip the escaped character.
+            i++;
+        }
+        else if (current == QChar('*') || current == QChar('?'))
+        {
+            hasWildcard = true;
+        }
+    }
+
+    if (windowName.startsWith(REGEXPREFIX))
+    {
+        pattern = QRegExp(windowName.mid(REGEXPREFIX.length()), Qt::CaseSensitive, QRegExp::RegExp2);
+        result = pattern.isValid() && !pattern.isEmpty();
+    }
+    else if (hasWildcard)
+    {
+        pattern = QRegExp(windowName, Qt::CaseSensitive, QRegExp::WildcardUnix);
+        result = pattern.isValid();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check a rule against the window in focus and keep it if it is the
+ *     best match for its controller so far. Every property set in the rule
+ *     has to match. Rules with more matched properties win and an exact
+ *     title wins over a title pattern.
+ * @param Rule to check
+ * @param Executable path of the window in focus
+ * @param Class of the window in focus
+ * @param Title of the window in focus
+ * @param Best score found so far for each controller GUID
+ * @param Best rule found so far for each controller GUID
+ */
+void AutoProfileWatcher::checkProfileMatch(AutoProfileInfo *info, QString appLocation,
+                                           QString windowClass, QString windowName,
+                                           QHash<QString, int> &highestMatchScore,
+                                           QHash<QString, AutoProfileInfo*> &highestMatches)
+{
+    if (info->isActive())
+    {
+        int numProps = 0;
+        numProps += !info->getExe().isEmpty() ? 1 : 0;
+        numProps += !info->getWindowClass().isEmpty() ? 1 : 0;
+        numProps += !info->getWindowName().isEmpty() ? 1 : 0;
+
+        int numMatched = 0;
+        numMatched += (!info->getExe().isEmpty() && info->getExe() == appLocation) ? 1 : 0;
+        numMatched += (!info->getWindowClass().isEmpty() && info->getWindowClass() == windowClass) ? 1 : 0;
+
+        bool patternMatched = false;
+        if (!info->getWindowName().isEmpty() && info->getWindowName() == windowName)
+        {
+            numMatched++;
+        }
+        else if (windowNamePatterns.contains(info))
+        {
+            QRegExp &pattern = windowNamePatterns[info];
+            if (pattern.patternSyntax() == QRegExp::WildcardUnix)
+            {
+                patternMatched = pattern.exactMatch(windowName);
+            }
+            else
+            {
+                patternMatched = pattern.indexIn(windowName) != -1;
+            }
+
+            numMatched += patternMatched ? 1 : 0;
+        }
+
+        if (numProps == numMatched)
+        {
+            int score = (numMatched * 2) - (patternMatched ? 1 : 0);
+            QString guid = info->getGUID();
+            if (!highestMatchScore.contains(guid) || score > highestMatchScore.value(guid))
+            {
+                highestMatchScore.insert(guid, score);
+                highestMatches.insert(guid, info);
+            }
+        }
+    }
+}
+
 void AutoProfileWatcher::syncProfileAssignment()
 {
     clearProfileAssignments();
@@ -318,6 +437,13 @@ void AutoProfileWatcher::syncProfileAssignment()
                     }
                     templist.append(info);
                     windowNameProfileAssignments.insert(windowName, templist);
+
+                    QRegExp pattern;
+                    if (buildWindowNamePattern(windowName, pattern))
+                    {
+                        windowNamePatterns.insert(info, pattern);
+                        windowNamePatternRules.append(info);
+                    }
                 }
 
                 if (!exe.isEmpty())
@@ -382,6 +508,8 @@ void AutoProfileWatcher::clearProfileAssignments()
         terminateProfiles.unite(templist.toSet());
     }
     windowNameProfileAssignments.clear();
+    windowNamePatterns.clear();
+    windowNamePatternRules.clear();
 
     QSetIterator<AutoProfileInfo*> iterTerminate(terminateProfiles);
     while (iterTerminate.hasNext())
@@ -427,7 +555,26 @@ QString AutoProfileWatcher::findAppLocation()
 
     if (pid > 0)
     {
-        exepath = X11Extras::getInstance()->getApplicationLocation(pid);
+        // X reuses window IDs. Only use the cached path while the window
+        // still belongs to the same process. Skips the /proc read.
+        QPair<int, QString> location = windowLocations.value(currentWindow);
+        if (location.first == pid)
+        {
+            exepath = location.second;
+        }
+        else
+        {
+            exepath = X11Extras::getInstance()->getApplicationLocation(pid);
+            if (!exepath.isEmpty())
+            {
+                if (windowLocations.size() >= MAXCACHEDLOCATIONS)
+                {
+                    windowLocations.clear();
+                }
+
+                windowLocations.insert(currentWindow, qMakePair(pid, exepath));
+            }
+        }
     }
     #endif
 
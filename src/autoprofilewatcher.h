@@ -6,10 +6,15 @@
 #include <QHash>
 #include <QList>
 #include <QSet>
+#include <QPair>
+#include <QRegExp>
 
 #include "autoprofileinfo.h"
 #include "antimicrosettings.h"
 
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+class X11FocusWatcher;
+#endif
 
 class AutoProfileWatcher : public QObject
 {
@@ -23,10 +28,17 @@ public:
     bool isGUIDLocked(QString guid);
 
     static const int CHECKTIME = 1000; // time in ms
+    static const int MAXCACHEDLOCATIONS = 64;
+    static const QString REGEXPREFIX;
 
 protected:
     QString findAppLocation();
     void clearProfileAssignments();
+    bool buildWindowNamePattern(QString windowName, QRegExp &pattern);
+    void checkProfileMatch(AutoProfileInfo *info, QString appLocation,
+                           QString windowClass, QString windowName,
+                           QHash<QString, int> &highestMatchScore,
+                           QHash<QString, AutoProfileInfo*> &highestMatches);
 
     QTimer appTimer;
     AntiMicroSettings *settings;
@@ -36,6 +48,10 @@ protected:
     QHash<QString, QList<AutoProfileInfo*> > windowClassProfileAssignments;
     // WM_NAME, QList<AutoProfileInfo*>
     QHash<QString, QList<AutoProfileInfo*> > windowNameProfileAssignments;
+    // Compiled title patterns of wildcard and regex title rules
+    QHash<AutoProfileInfo*, QRegExp> windowNamePatterns;
+    // Rules with a compiled title pattern in the order they are stored
+    QList<AutoProfileInfo*> windowNamePatternRules;
     // GUID, AutoProfileInfo*
     QHash<QString, AutoProfileInfo*> defaultProfileAssignments;
     //QList<AutoProfileInfo*> *customDefaults;
@@ -44,6 +60,12 @@ protected:
     QString currentAppWindowTitle;
     QSet<QString> guidSet;
 
+#if defined(Q_OS_UNIX) && defined(WITH_X11)
+    X11FocusWatcher *focusWatcher;
+    // Window XID, pid of the owning process and executable path
+    QHash<unsigned long, QPair<int, QString> > windowLocations;
+#endif
+
 signals:
     void foundApplicableProfile(AutoProfileInfo *info);
 
@@ -8,6 +8,7 @@
 #include "event.h"
 #include "antkeymapper.h"
 #include "setjoystick.h"
+#include "uiupdatebus.h"
 
 AxisEditDialog::AxisEditDialog(JoyAxis *axis, QWidget *parent) :
     QDialog(parent, Qt::Window),
@@ -275,7 +276,18 @@ void AxisEditDialog::updateThrottleUi(int index)
 
 void AxisEditDialog::updateJoyValue(int value)
 {
-    ui->joyValueLabel->setText(QString::number(value));
+    Q_UNUSED(value);
+
+    UiUpdateBus::getInstance()->scheduleUpdate(this);
+}
+
+/**
+ * @brief Show the current axis value. Called once per frame by the UI
+ *     update bus while the axis is moving.
+ */
+void AxisEditDialog::applyFrameUpdate()
+{
+    ui->joyValueLabel->setText(QString::number(axis->getCurrentRawValue()));
 }
 
 void AxisEditDialog::updateDeadZoneSlider(QString value)
@@ -43,6 +43,7 @@ private slots:
     void updateMaxZoneBox(int value);
     void updateThrottleUi(int index);
     void updateJoyValue(int value);
+    void applyFrameUpdate();
     void updateDeadZoneSlider(QString value);
     void updateMaxZoneSlider(QString value);
     void openAdvancedPDialog();
@@ -3,6 +3,7 @@
 
 #include "axisvaluebox.h"
 #include "joyaxis.h"
+#include "uiupdatebus.h"
 
 AxisValueBox::AxisValueBox(QWidget *parent) :
     QWidget(parent)
@@ -10,6 +11,7 @@ AxisValueBox::AxisValueBox(QWidget *parent) :
     deadZone = 0;
     maxZone = 0;
     joyValue = 0;
+    pendingValue = 0;
     throttle = 0;
     lboxstart = 0;
     lboxend = 0;
@@ -22,13 +24,25 @@ void AxisValueBox::setThrottle(int throttle)
     if (throttle <= JoyAxis::PositiveHalfThrottle && throttle >= JoyAxis::NegativeHalfThrottle)
     {
         this->throttle = throttle;
-        setValue(joyValue);
+        setValue(pendingValue);
     }
     update();
 }
 
+/**
+ * @brief Record a new raw axis value. The box is redrawn with the newest
+ *     value on the next frame of the UI update bus.
+ * @param Raw axis value
+ */
 void AxisValueBox::setValue(int value)
 {
+    pendingValue = value;
+    UiUpdateBus::getInstance()->scheduleUpdate(this);
+}
+
+void AxisValueBox::applyFrameUpdate()
+{
+    int value = pendingValue;
     if (value >= JoyAxis::AXISMIN && value <= JoyAxis::AXISMAX)
     {
         if (throttle == JoyAxis::NormalThrottle)
@@ -21,6 +21,8 @@ protected:
     int deadZone;
     int maxZone;
     int joyValue;
+    // Newest raw value that has not been drawn yet.
+    int pendingValue;
     int throttle;
     int boxwidth;
     int boxheight;
@@ -39,6 +41,8 @@ public slots:
     void setDeadZone(int deadZone);
     void setMaxZone(int maxZone);
 
+private slots:
+    void applyFrameUpdate();
 };
 
 #endif // AXISVALUEBOX_H
@@ -0,0 +1,26 @@
+#include "benchedgerecorder.h"
+
+BenchEdgeRecorder::BenchEdgeRecorder(QObject *parent) :
+    QObject(parent)
+{
+}
+
+/**
+ * @brief Get the recorded edges in the order they happened. A press
+ *     is stored as +index and a release as -index.
+ * @return Recorded edges
+ */
+QStringList BenchEdgeRecorder::getEdges()
+{
+    return edges;
+}
+
+void BenchEdgeRecorder::recordPress(int index)
+{
+    edges.append(QString("+%1").arg(index));
+}
+
+void BenchEdgeRecorder::recordRelease(int index)
+{
+    edges.append(QString("-%1").arg(index));
+}
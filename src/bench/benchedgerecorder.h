@@ -0,0 +1,29 @@
+#ifndef BENCHEDGERECORDER_H
+#define BENCHEDGERECORDER_H
+
+#include <QObject>
+#include <QStringList>
+
+/**
+ * @brief Records the press and release edges of the buttons connected to
+ *     it. Used by the bench checks to verify that no edge gets lost.
+ */
+class BenchEdgeRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BenchEdgeRecorder(QObject *parent=0);
+
+    QStringList getEdges();
+
+protected:
+    QStringList edges;
+
+signals:
+
+public slots:
+    void recordPress(int index);
+    void recordRelease(int index);
+};
+
+#endif // BENCHEDGERECORDER_H
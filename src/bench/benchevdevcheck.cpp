@@ -0,0 +1,402 @@
+//#include <QDebug>
+#include <QThread>
+#include <QMap>
+#include <QVector>
+#include <QElapsedTimer>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+#include "benchevdevcheck.h"
+#include "joystick.h"
+#include "evdeveventreader.h"
+
+static const char gamepadName[] = "antimicro bench gamepad";
+
+// Reports in the burst written with a single write call. Large enough to
+// overflow the kernel buffer of a reader but small enough for the evdev
+// ring buffer to hold every resulting event.
+const int BenchEvdevCheck::BURSTREPORTS = 300;
+
+BenchEvdevCheck::BenchEvdevCheck(AntiMicroSettings *settings, QObject *parent) :
+    QObject(parent)
+{
+    this->settings = settings;
+    uinputFd = -1;
+    deviceID = -1;
+}
+
+BenchEvdevCheck::~BenchEvdevCheck()
+{
+    destroyGamepad();
+}
+
+/**
+ * @brief Run the check. The check is skipped when the uinput node cannot
+ *     be opened or SDL does not pick up the virtual gamepad.
+ * @param Stream used for the result
+ * @return Whether evdev and SDL reported the same element events. True
+ *     when skipped.
+ */
+bool BenchEvdevCheck::run(QTextStream &out)
+{
+    if (!createGamepad())
+    {
+        out << "evdev-uinput: SKIP (could not create a uinput device)" << endl;
+        return true;
+    }
+
+    SDL_Joystick *joyhandle = openGamepad();
+    if (!joyhandle)
+    {
+        out << "evdev-uinput: SKIP (SDL did not detect the virtual gamepad)" << endl;
+        return true;
+    }
+
+    deviceID = SDL_JoystickInstanceID(joyhandle);
+    Joystick *device = new Joystick(joyhandle, 0, settings);
+
+    EvdevEventReader *reader = new EvdevEventReader();
+    QThread *readerThread = new QThread();
+    reader->moveToThread(readerThread);
+    connect(readerThread, SIGNAL(started()), reader, SLOT(performWork()));
+    readerThread->start();
+
+    bool passed = reader->addDevice(device);
+    if (!passed)
+    {
+        out << "evdev-uinput: FAIL (evdev reader did not accept the virtual gamepad)" << endl;
+    }
+
+    QStringList sdlEvents;
+    QStringList evdevEvents;
+
+    if (passed)
+    {
+        // Drop anything reported while both readers opened the device.
+        usleep(100000);
+        collectEvents(sdlEvents, evdevEvents, reader);
+        sdlEvents.clear();
+        evdevEvents.clear();
+
+        // First movements are large so the initial jitter filter of SDL
+        // does not hide them.
+        passed = writeReport(EV_ABS, ABS_X, 20000) &&
+                writeReport(EV_ABS, ABS_Y, -20000) &&
+                writeReport(EV_KEY, BTN_SOUTH, 1) &&
+                writeReport(EV_ABS, ABS_HAT0X, 1) &&
+                writeReport(EV_ABS, ABS_HAT0Y, 1) &&
+                writeReport(EV_ABS, ABS_RX, 30000) &&
+                writeReport(EV_ABS, ABS_RX, 100) &&
+                writeReport(EV_KEY, BTN_EAST, 1) &&
+                writeReport(EV_KEY, BTN_SOUTH, 0) &&
+                writeReport(EV_ABS, ABS_HAT0X, 0) &&
+                writeReport(EV_ABS, ABS_X, -32768) &&
+                writeReport(EV_ABS, ABS_X, 32767) &&
+                writeReport(EV_KEY, BTN_EAST, 0) &&
+                writeReport(EV_ABS, ABS_HAT0Y, 0) &&
+                writeReport(EV_ABS, ABS_Y, 0);
+
+        if (passed)
+        {
+            usleep(100000);
+            collectEvents(sdlEvents, evdevEvents, reader);
+            passed = compareEvents("scripted", sdlEvents, evdevEvents, out);
+        }
+        else
+        {
+            out << "evdev-uinput: FAIL (could not write to the uinput device)" << endl;
+        }
+    }
+
+    if (passed)
+    {
+        sdlEvents.clear();
+        evdevEvents.clear();
+
+        QVector<struct input_event> burst(BURSTREPORTS * 3);
+        memset(burst.data(), 0, sizeof(struct input_event) * burst.size());
+        for (int i=0; i < BURSTREPORTS; i++)
+        {
+            struct input_event *events = burst.data() + (i * 3);
+            events[0].type = EV_ABS;
+            events[0].code = ABS_X;
+            events[0].value = ((i * 2731) % 60000) - 30000;
+            events[1].type = EV_KEY;
+            events[1].code = BTN_NORTH;
+            events[1].value = i % 2;
+            events[2].type = EV_SYN;
+            events[2].code = SYN_REPORT;
+        }
+
+        passed = writeEvents(burst.constData(), burst.size());
+        if (passed)
+        {
+            usleep(200000);
+            collectEvents(sdlEvents, evdevEvents, reader);
+
+            // Readers that fell behind resynchronize after SYN_DROPPED so
+            // only the final element state has to match.
+            passed = compareEvents("burst", finalValues(sdlEvents),
+                                   finalValues(evdevEvents), out);
+        }
+        else
+        {
+            out << "evdev-uinput: FAIL (could not write to the uinput device)" << endl;
+        }
+    }
+
+    reader->stop();
+    readerThread->quit();
+    readerThread->wait();
+    delete reader;
+    reader = 0;
+    delete readerThread;
+    readerThread = 0;
+
+    device->closeSDLDevice();
+    delete device;
+    device = 0;
+
+    if (passed)
+    {
+        out << "evdev-uinput: PASS" << endl;
+    }
+
+    return passed;
+}
+
+bool BenchEvdevCheck::createGamepad()
+{
+    bool result = false;
+
+    uinputFd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (uinputFd < 0)
+    {
+        uinputFd = open("/dev/input/uinput", O_WRONLY | O_NONBLOCK);
+    }
+
+    if (uinputFd >= 0)
+    {
+        ioctl(uinputFd, UI_SET_EVBIT, EV_SYN);
+        ioctl(uinputFd, UI_SET_EVBIT, EV_KEY);
+        ioctl(uinputFd, UI_SET_EVBIT, EV_ABS);
+
+        const int buttons[] = {BTN_SOUTH, BTN_EAST, BTN_NORTH, BTN_WEST,
+                               BTN_TL, BTN_TR, BTN_SELECT, BTN_START};
+        for (unsigned int i=0; i < sizeof(buttons) / sizeof(buttons[0]); i++)
+        {
+            ioctl(uinputFd, UI_SET_KEYBIT, buttons[i]);
+        }
+
+        struct uinput_user_dev uidev;
+        memset(&uidev, 0, sizeof(uidev));
+        strncpy(uidev.name, gamepadName, UINPUT_MAX_NAME_SIZE - 1);
+        uidev.id.bustype = BUS_VIRTUAL;
+        uidev.id.vendor  = 0x0;
+        uidev.id.product = 0x0;
+        uidev.id.version = 1;
+
+        const int axes[] = {ABS_X, ABS_Y, ABS_RX};
+        for (unsigned int i=0; i < sizeof(axes) / sizeof(axes[0]); i++)
+        {
+            ioctl(uinputFd, UI_SET_ABSBIT, axes[i]);
+            uidev.absmin[axes[i]] = -32768;
+            uidev.absmax[axes[i]] = 32767;
+        }
+
+        // Exercise the flat zone handling of both readers.
+        uidev.absflat[ABS_RX] = 4096;
+
+        ioctl(uinputFd, UI_SET_ABSBIT, ABS_HAT0X);
+        ioctl(uinputFd, UI_SET_ABSBIT, ABS_HAT0Y);
+        uidev.absmin[ABS_HAT0X] = -1;
+        uidev.absmax[ABS_HAT0X] = 1;
+        uidev.absmin[ABS_HAT0Y] = -1;
+        uidev.absmax[ABS_HAT0Y] = 1;
+
+        if (write(uinputFd, &uidev, sizeof(uidev)) == sizeof(uidev) &&
+            ioctl(uinputFd, UI_DEV_CREATE) >= 0)
+        {
+            result = true;
+        }
+        else
+        {
+            close(uinputFd);
+            uinputFd = -1;
+        }
+    }
+
+    return result;
+}
+
+void BenchEvdevCheck::destroyGamepad()
+{
+    if (uinputFd >= 0)
+    {
+        ioctl(uinputFd, UI_DEV_DESTROY);
+        close(uinputFd);
+        uinputFd = -1;
+    }
+}
+
+/**
+ * @brief Wait for SDL to list the virtual gamepad and open it.
+ * @return SDL joystick handle. NULL if the gamepad was not found in time.
+ */
+SDL_Joystick* BenchEvdevCheck::openGamepad()
+{
+    SDL_Joystick *result = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!result && timer.elapsed() < 3000)
+    {
+        SDL_PumpEvents();
+        for (int i=0; i < SDL_NumJoysticks() && !result; i++)
+        {
+            const char *name = SDL_JoystickNameForIndex(i);
+            if (name && strcmp(name, gamepadName) == 0)
+            {
+                result = SDL_JoystickOpen(i);
+            }
+        }
+
+        if (!result)
+        {
+            usleep(20000);
+        }
+    }
+
+    return result;
+}
+
+bool BenchEvdevCheck::writeEvents(const struct input_event *events, int count)
+{
+    ssize_t size = sizeof(struct input_event) * count;
+    return write(uinputFd, events, size) == size;
+}
+
+/**
+ * @brief Write a single element change followed by SYN_REPORT.
+ */
+bool BenchEvdevCheck::writeReport(int type, int code, int value)
+{
+    struct input_event events[2];
+    memset(events, 0, sizeof(events));
+    events[0].type = type;
+    events[0].code = code;
+    events[0].value = value;
+    events[1].type = EV_SYN;
+    events[1].code = SYN_REPORT;
+
+    return writeEvents(events, 2);
+}
+
+/**
+ * @brief Take the pending element events of the virtual gamepad from SDL
+ *     and from the evdev reader.
+ */
+void BenchEvdevCheck::collectEvents(QStringList &sdlEvents, QStringList &evdevEvents,
+                                    EvdevEventReader *reader)
+{
+    SDL_Event event;
+    while (SDL_PollEvent(&event) > 0)
+    {
+        QString temp = describeEvent(event);
+        if (!temp.isEmpty())
+        {
+            sdlEvents.append(temp);
+        }
+    }
+
+    if (reader)
+    {
+        QQueue<SDL_Event> readerEvents;
+        reader->takeEvents(&readerEvents);
+        while (!readerEvents.isEmpty())
+        {
+            QString temp = describeEvent(readerEvents.dequeue());
+            if (!temp.isEmpty())
+            {
+                evdevEvents.append(temp);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Describe an element event of the virtual gamepad as element type,
+ *     index and value. Events of other devices give an empty string.
+ */
+QString BenchEvdevCheck::describeEvent(const SDL_Event &event)
+{
+    QString result;
+
+    switch (event.type)
+    {
+        case SDL_JOYAXISMOTION:
+        {
+            if (event.jaxis.which == deviceID)
+            {
+                result = QString("axis%1=%2").arg(event.jaxis.axis).arg(event.jaxis.value);
+            }
+            break;
+        }
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        {
+            if (event.jbutton.which == deviceID)
+            {
+                result = QString("button%1=%2").arg(event.jbutton.button)
+                        .arg(event.type == SDL_JOYBUTTONDOWN ? 1 : 0);
+            }
+            break;
+        }
+        case SDL_JOYHATMOTION:
+        {
+            if (event.jhat.which == deviceID)
+            {
+                result = QString("hat%1=%2").arg(event.jhat.hat).arg(event.jhat.value);
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Reduce an event list to the last value of every element.
+ */
+QStringList BenchEvdevCheck::finalValues(const QStringList &events)
+{
+    QMap<QString, QString> values;
+    QStringListIterator iter(events);
+    while (iter.hasNext())
+    {
+        QString temp = iter.next();
+        values.insert(temp.section('=', 0, 0), temp);
+    }
+
+    return values.values();
+}
+
+bool BenchEvdevCheck::compareEvents(QString phase, const QStringList &expected,
+                                    const QStringList &actual, QTextStream &out)
+{
+    bool result = expected == actual;
+    if (!result)
+    {
+        out << QString("evdev-uinput: FAIL (%1 input)").arg(phase) << endl;
+        out << QString("SDL:   %1").arg(expected.join(" ")) << endl;
+        out << QString("evdev: %1").arg(actual.join(" ")) << endl;
+    }
+
+    return result;
+}
@@ -0,0 +1,59 @@
+#ifndef BENCHEVDEVCHECK_H
+#define BENCHEVDEVCHECK_H
+
+#include <QObject>
+#include <QStringList>
+#include <QQueue>
+#include <QTextStream>
+
+#include <SDL2/SDL.h>
+
+#include "antimicrosettings.h"
+
+struct input_event;
+class EvdevEventReader;
+
+/**
+ * @brief Compare the element events produced by the evdev reader with the
+ *     ones SDL produces for the same device. A virtual gamepad is created
+ *     through uinput and opened through SDL while EvdevEventReader reads
+ *     the same node. Both streams are collected and compared after
+ *     scripted input and after a burst large enough to overflow the kernel
+ *     buffer of a reader. Only compiled with WITH_EVDEV and WITH_UINPUT.
+ */
+class BenchEvdevCheck : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BenchEvdevCheck(AntiMicroSettings *settings, QObject *parent=0);
+    ~BenchEvdevCheck();
+
+    bool run(QTextStream &out);
+
+    static const int BURSTREPORTS;
+
+protected:
+    bool createGamepad();
+    void destroyGamepad();
+    SDL_Joystick* openGamepad();
+
+    bool writeEvents(const struct input_event *events, int count);
+    bool writeReport(int type, int code, int value);
+    void collectEvents(QStringList &sdlEvents, QStringList &evdevEvents,
+                       EvdevEventReader *reader);
+    QString describeEvent(const SDL_Event &event);
+    QStringList finalValues(const QStringList &events);
+    bool compareEvents(QString phase, const QStringList &expected,
+                       const QStringList &actual, QTextStream &out);
+
+    AntiMicroSettings *settings;
+    int uinputFd;
+    SDL_JoystickID deviceID;
+
+signals:
+
+public slots:
+
+};
+
+#endif // BENCHEVDEVCHECK_H
@@ -0,0 +1,48 @@
+#include "benchinputdaemon.h"
+#include "eventhandlerfactory.h"
+
+BenchInputDaemon::BenchInputDaemon(QMap<SDL_JoystickID, InputDevice *> *joysticks,
+                                   AntiMicroSettings *settings, QObject *parent) :
+    InputDaemon(joysticks, settings, false, parent)
+{
+}
+
+/**
+ * @brief Register a virtual device so that events carrying its
+ *     SDL_JoystickID are routed to it.
+ * @param Virtual device
+ */
+void BenchInputDaemon::addBenchDevice(Joystick *device)
+{
+#ifdef USE_SDL_2
+    SDL_JoystickID deviceID = device->getSDLJoystickID();
+    trackjoysticks.insert(deviceID, device);
+#else
+    SDL_JoystickID deviceID = device->getJoyNumber();
+#endif
+
+    joysticks->insert(deviceID, device);
+}
+
+/**
+ * @brief Run all events currently waiting in the SDL queue through the
+ *     same passes used by InputDaemon::run.
+ */
+void BenchInputDaemon::processPendingEvents()
+{
+    JoyButton::resetActiveButtonMouseDistances();
+
+    QQueue<SDL_Event> sdlEventQueue;
+
+    firstInputPass(&sdlEventQueue);
+
+#ifdef USE_SDL_2
+    modifyUnplugEvents(&sdlEventQueue);
+#endif
+
+    secondInputPass(&sdlEventQueue);
+
+    clearBitArrayStatusInstances();
+
+    EventHandlerFactory::flushHandlerEvents();
+}
@@ -0,0 +1,26 @@
+#ifndef BENCHINPUTDAEMON_H
+#define BENCHINPUTDAEMON_H
+
+#include "inputdaemon.h"
+
+/**
+ * @brief InputDaemon that is driven manually by the benchmark harness
+ *     rather than by the SDL event reader thread.
+ */
+class BenchInputDaemon : public InputDaemon
+{
+    Q_OBJECT
+public:
+    explicit BenchInputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks,
+                              AntiMicroSettings *settings, QObject *parent=0);
+
+    void addBenchDevice(Joystick *device);
+    void processPendingEvents();
+
+signals:
+
+public slots:
+
+};
+
+#endif // BENCHINPUTDAEMON_H
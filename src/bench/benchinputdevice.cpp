@@ -0,0 +1,61 @@
+#include "benchinputdevice.h"
+
+BenchInputDevice::BenchInputDevice(SDL_JoystickID deviceID, int numButtons, int numAxes,
+                                   int numHats, AntiMicroSettings *settings, QObject *parent) :
+    Joystick(0, 0, settings, parent)
+{
+    this->numButtons = numButtons;
+    this->numAxes = numAxes;
+    this->numHats = numHats;
+
+#ifdef USE_SDL_2
+    joystickID = deviceID;
+#else
+    joyNumber = deviceID;
+#endif
+
+    // Sets were populated by the Joystick constructor before the element
+    // counts were known. Rebuild them now.
+    reset();
+}
+
+QString BenchInputDevice::getName()
+{
+    return QString("Bench Joystick");
+}
+
+QString BenchInputDevice::getSDLName()
+{
+    return QString("antimicro bench device");
+}
+
+QString BenchInputDevice::getGUIDString()
+{
+    return QString();
+}
+
+void BenchInputDevice::closeSDLDevice()
+{
+}
+
+#ifdef USE_SDL_2
+SDL_JoystickID BenchInputDevice::getSDLJoystickID()
+{
+    return joystickID;
+}
+#endif
+
+int BenchInputDevice::getNumberRawButtons()
+{
+    return numButtons;
+}
+
+int BenchInputDevice::getNumberRawAxes()
+{
+    return numAxes;
+}
+
+int BenchInputDevice::getNumberRawHats()
+{
+    return numHats;
+}
@@ -0,0 +1,41 @@
+#ifndef BENCHINPUTDEVICE_H
+#define BENCHINPUTDEVICE_H
+
+#include "joystick.h"
+
+/**
+ * @brief Joystick that is not backed by real hardware. Element counts are
+ *     fixed at construction so that synthetic SDL events can be routed
+ *     through the regular mapping code.
+ */
+class BenchInputDevice : public Joystick
+{
+    Q_OBJECT
+public:
+    explicit BenchInputDevice(SDL_JoystickID deviceID, int numButtons, int numAxes,
+                              int numHats, AntiMicroSettings *settings, QObject *parent=0);
+
+    virtual QString getName();
+    virtual QString getSDLName();
+    virtual QString getGUIDString();
+    virtual void closeSDLDevice();
+#ifdef USE_SDL_2
+    virtual SDL_JoystickID getSDLJoystickID();
+#endif
+
+    virtual int getNumberRawButtons();
+    virtual int getNumberRawAxes();
+    virtual int getNumberRawHats();
+
+protected:
+    int numButtons;
+    int numAxes;
+    int numHats;
+
+signals:
+
+public slots:
+
+};
+
+#endif // BENCHINPUTDEVICE_H
@@ -0,0 +1,533 @@
+#include <QApplication>
+#include <QMap>
+#include <QList>
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <ctime>
+#include <cmath>
+#include <cstring>
+
+#include "inputdevice.h"
+#include "setjoystick.h"
+#include "joycontrolstick.h"
+#include "joybuttonslot.h"
+#include "antimicrosettings.h"
+#include "xmlconfigreader.h"
+#include "eventhandlerfactory.h"
+#include "antkeymapper.h"
+#include "logger.h"
+#include "inputtrace.h"
+
+#include "bench/benchinputdaemon.h"
+#include "bench/benchinputdevice.h"
+#include "bench/benchedgerecorder.h"
+
+#if defined(WITH_EVDEV) && defined(WITH_UINPUT)
+#include "bench/benchevdevcheck.h"
+#endif
+
+// Instance ID used for the virtual device. Kept below 256 so that
+// it also fits the device index used by SDL 1.2 events.
+static const SDL_JoystickID BENCH_DEVICE_ID = 250;
+// Instance ID used for the device created by --check.
+static const SDL_JoystickID BENCH_CHECK_DEVICE_ID = 251;
+
+typedef struct {
+    QString profileLocation;
+    QString traceLocation;
+    QString checkName;
+    int numEvents;
+    int batchSize;
+    int numButtons;
+    int numAxes;
+    int numHats;
+    unsigned int seed;
+} BenchOptions;
+
+static QStringList availableChecks()
+{
+    QStringList checks;
+    checks.append("stick-edges");
+#if defined(WITH_EVDEV) && defined(WITH_UINPUT)
+    checks.append("evdev-uinput");
+#endif
+
+    return checks;
+}
+
+static void printUsage(QTextStream &out)
+{
+    out << "Usage: antimicro_bench [options]" << endl;
+    out << endl;
+    out << "Options:" << endl;
+    out << "--profile <location>          " << " " << "Profile to load for the virtual device." << endl;
+    out << "--trace <location>            " << " " << "Replay a recorded input trace instead of synthetic events." << endl;
+    out << "--events <number>             " << " " << "Number of synthetic events to replay. Default: 200000." << endl;
+    out << "--batch <number>              " << " " << "Events handled per poll cycle. Default: 8." << endl;
+    out << "--buttons <number>            " << " " << "Buttons on the virtual device. Default: 16." << endl;
+    out << "--axes <number>               " << " " << "Axes on the virtual device. Default: 6." << endl;
+    out << "--hats <number>               " << " " << "Hats on the virtual device. Default: 1." << endl;
+    out << "--seed <number>               " << " " << "Seed used to generate the event stream. Default: 1." << endl;
+    out << "--check <name>                " << " " << "Run a correctness check instead of the benchmark." << endl;
+    out << "                              " << " " << QString("Available checks: %1.").arg(availableChecks().join(", ")) << endl;
+}
+
+static bool parseArguments(QStringList arguments, BenchOptions &options, QTextStream &err)
+{
+    bool result = true;
+    QStringListIterator iter(arguments);
+    // Skip program name.
+    iter.next();
+
+    while (iter.hasNext() && result)
+    {
+        QString temp = iter.next();
+        if (temp == "--profile" && iter.hasNext())
+        {
+            options.profileLocation = QFileInfo(iter.next()).absoluteFilePath();
+        }
+        else if (temp == "--trace" && iter.hasNext())
+        {
+            options.traceLocation = QFileInfo(iter.next()).absoluteFilePath();
+        }
+        else if (temp == "--check" && iter.hasNext())
+        {
+            options.checkName = iter.next();
+            if (!availableChecks().contains(options.checkName))
+            {
+                err << QString("Unknown check %1.").arg(options.checkName) << endl;
+                result = false;
+            }
+        }
+        else if ((temp == "--events" || temp == "--batch" || temp == "--buttons" ||
+                  temp == "--axes" || temp == "--hats" || temp == "--seed") && iter.hasNext())
+        {
+            bool validNumber = false;
+            int tempNumber = iter.next().toInt(&validNumber);
+            if (!validNumber || tempNumber < 0)
+            {
+                err << QString("Invalid value given for %1.").arg(temp) << endl;
+                result = false;
+            }
+            else if (temp == "--events")
+            {
+                options.numEvents = tempNumber;
+            }
+            else if (temp == "--batch")
+            {
+                options.batchSize = qMax(1, tempNumber);
+            }
+            else if (temp == "--buttons")
+            {
+                options.numButtons = tempNumber;
+            }
+            else if (temp == "--axes")
+            {
+                options.numAxes = tempNumber;
+            }
+            else if (temp == "--hats")
+            {
+                options.numHats = tempNumber;
+            }
+            else if (temp == "--seed")
+            {
+                options.seed = tempNumber;
+            }
+        }
+        else
+        {
+            err << QString("Unknown option %1.").arg(temp) << endl;
+            result = false;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Generate a deterministic event stream resembling gameplay. Axes
+ *     sweep continuously while buttons and hats change state at random
+ *     points in the stream.
+ */
+static void buildSyntheticTrace(QList<SDL_Event> &trace, const BenchOptions &options)
+{
+    QList<bool> buttonStates;
+    for (int i=0; i < options.numButtons; i++)
+    {
+        buttonStates.append(false);
+    }
+
+    const Uint8 hatValues[] = {SDL_HAT_CENTERED, SDL_HAT_UP, SDL_HAT_RIGHT,
+                               SDL_HAT_DOWN, SDL_HAT_LEFT};
+
+    qsrand(options.seed);
+
+    for (int i=0; i < options.numEvents; i++)
+    {
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+
+        int choice = qrand() % 100;
+        if (choice < 75 && options.numAxes > 0)
+        {
+            int axis = i % options.numAxes;
+            double phase = (i / static_cast<double>(options.numAxes)) * 0.01 + axis;
+
+            event.type = SDL_JOYAXISMOTION;
+            event.jaxis.which = BENCH_DEVICE_ID;
+            event.jaxis.axis = axis;
+            event.jaxis.value = static_cast<Sint16>(sin(phase) * 32767.0);
+        }
+        else if (choice < 95 && options.numButtons > 0)
+        {
+            int button = qrand() % options.numButtons;
+            bool pressed = !buttonStates.at(button);
+            buttonStates[button] = pressed;
+
+            event.type = pressed ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+            event.jbutton.which = BENCH_DEVICE_ID;
+            event.jbutton.button = button;
+            event.jbutton.state = pressed ? SDL_PRESSED : SDL_RELEASED;
+        }
+        else if (options.numHats > 0)
+        {
+            event.type = SDL_JOYHATMOTION;
+            event.jhat.which = BENCH_DEVICE_ID;
+            event.jhat.hat = qrand() % options.numHats;
+            event.jhat.value = hatValues[qrand() % 5];
+        }
+        else
+        {
+            continue;
+        }
+
+        trace.append(event);
+    }
+}
+
+/**
+ * @brief Load events recorded with --record-input. Every recorded device
+ *     is folded onto the virtual device, which is sized to fit the
+ *     largest recorded device. Game controller events keep their
+ *     controller element numbers. Timing is ignored so the trace is
+ *     replayed as fast as possible.
+ */
+static bool loadRecordedTrace(QList<SDL_Event> &trace, BenchOptions &options, QTextStream &err)
+{
+    QList<InputTrace::TraceDevice> traceDevices;
+    QList<InputTrace::TraceEvent> traceEvents;
+    QString errorString;
+
+    if (!InputTrace::readTraceFile(options.traceLocation, traceDevices, traceEvents, errorString))
+    {
+        err << errorString << endl;
+        return false;
+    }
+
+    options.numButtons = 0;
+    options.numAxes = 0;
+    options.numHats = 0;
+
+    QListIterator<InputTrace::TraceDevice> deviceIter(traceDevices);
+    while (deviceIter.hasNext())
+    {
+        const InputTrace::TraceDevice &traceDevice = deviceIter.next();
+        options.numButtons = qMax(options.numButtons, static_cast<int>(traceDevice.numButtons));
+        options.numAxes = qMax(options.numAxes, static_cast<int>(traceDevice.numAxes));
+        options.numHats = qMax(options.numHats, static_cast<int>(traceDevice.numHats));
+
+#ifdef USE_SDL_2
+        if (traceDevice.gameController)
+        {
+            options.numButtons = qMax(options.numButtons, static_cast<int>(SDL_CONTROLLER_BUTTON_MAX));
+            options.numAxes = qMax(options.numAxes, static_cast<int>(SDL_CONTROLLER_AXIS_MAX));
+        }
+#endif
+    }
+
+    QListIterator<InputTrace::TraceEvent> eventIter(traceEvents);
+    while (eventIter.hasNext())
+    {
+        SDL_Event event;
+        if (InputTrace::createSDLEvent(eventIter.next(), BENCH_DEVICE_ID, false, &event))
+        {
+            trace.append(event);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Move an eight way stick through three directions within one poll
+ *     and make sure that every direction button is pressed and released
+ *     in order. Guards against axis coalescing in InputDaemon merging
+ *     samples that belong to different stick directions.
+ * @return Whether every expected edge was seen
+ */
+static bool runStickEdgeCheck(BenchInputDaemon *daemon, AntiMicroSettings *settings,
+                              QTextStream &out)
+{
+    BenchInputDevice *device = new BenchInputDevice(BENCH_CHECK_DEVICE_ID, 0, 2, 0, settings);
+    daemon->addBenchDevice(device);
+
+    SetJoystick *currentSet = device->getActiveSetJoystick();
+    JoyControlStick *stick = new JoyControlStick(currentSet->getJoyAxis(0),
+                                                 currentSet->getJoyAxis(1), 0,
+                                                 currentSet->getIndex(), currentSet);
+    currentSet->addControlStick(0, stick);
+    stick->setJoyMode(JoyControlStick::EightWayMode);
+
+    BenchEdgeRecorder recorder;
+    QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> iter(*stick->getButtons());
+    while (iter.hasNext())
+    {
+        JoyControlStickButton *button = iter.next().value();
+        QObject::connect(button, SIGNAL(clicked(int)), &recorder, SLOT(recordPress(int)));
+        QObject::connect(button, SIGNAL(released(int)), &recorder, SLOT(recordRelease(int)));
+    }
+
+    // Axis number and value pairs. The first poll goes Down, RightDown
+    // and Right. The Y axis keeps pointing down for both of its samples
+    // so only the paired X axis sample in between tells them apart.
+    // The second poll centers the stick again.
+    const int firstPoll[][2] = {{1, 30000}, {0, 30000}, {1, 10000}};
+    const int secondPoll[][2] = {{1, 0}, {0, 0}};
+
+    for (int i=0; i < 3; i++)
+    {
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+        event.type = SDL_JOYAXISMOTION;
+        event.jaxis.which = BENCH_CHECK_DEVICE_ID;
+        event.jaxis.axis = firstPoll[i][0];
+        event.jaxis.value = firstPoll[i][1];
+        SDL_PushEvent(&event);
+    }
+
+    daemon->processPendingEvents();
+
+    for (int i=0; i < 2; i++)
+    {
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+        event.type = SDL_JOYAXISMOTION;
+        event.jaxis.which = BENCH_CHECK_DEVICE_ID;
+        event.jaxis.axis = secondPoll[i][0];
+        event.jaxis.value = secondPoll[i][1];
+        SDL_PushEvent(&event);
+    }
+
+    daemon->processPendingEvents();
+
+    QStringList expected;
+    expected << QString("+%1").arg(JoyControlStick::StickDown)
+             << QString("-%1").arg(JoyControlStick::StickDown)
+             << QString("+%1").arg(JoyControlStick::StickRightDown)
+             << QString("-%1").arg(JoyControlStick::StickRightDown)
+             << QString("+%1").arg(JoyControlStick::StickRight)
+             << QString("-%1").arg(JoyControlStick::StickRight);
+
+    QStringList edges = recorder.getEdges();
+    bool passed = edges == expected;
+    out << QString("stick-edges: %1").arg(passed ? "PASS" : "FAIL") << endl;
+    if (!passed)
+    {
+        out << QString("Expected: %1").arg(expected.join(" ")) << endl;
+        out << QString("Got:      %1").arg(edges.join(" ")) << endl;
+    }
+
+    return passed;
+}
+
+int main(int argc, char *argv[])
+{
+    qRegisterMetaType<JoyButtonSlot*>();
+    qRegisterMetaType<InputDevice*>();
+
+    QTextStream outstream(stdout);
+    QTextStream errorstream(stderr);
+
+    // Run without a display so the bench also works on CI machines.
+    // QApplication is still used because spring mouse profiles query the
+    // desktop geometry through QApplication::desktop().
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+#else
+    // Qt 4 can only skip the display connection entirely. Spring mouse
+    // profiles then need a display.
+    QApplication a(argc, argv, !qgetenv("DISPLAY").isEmpty());
+#endif
+
+    BenchOptions options;
+    options.numEvents = 200000;
+    options.batchSize = 8;
+    options.numButtons = 16;
+    options.numAxes = 6;
+    options.numHats = 1;
+    options.seed = 1;
+
+    QStringList arguments = a.arguments();
+    if (arguments.contains("-h") || arguments.contains("--help"))
+    {
+        printUsage(outstream);
+        return 0;
+    }
+    else if (!parseArguments(arguments, options, errorstream))
+    {
+        printUsage(errorstream);
+        return 1;
+    }
+
+    QList<SDL_Event> trace;
+    if (!options.traceLocation.isEmpty() &&
+        !loadRecordedTrace(trace, options, errorstream))
+    {
+        return 1;
+    }
+
+    Logger appLogger(&outstream, &errorstream, Logger::LOG_ERROR);
+
+    // Use a scratch settings file so the user configuration is never touched.
+    AntiMicroSettings settings(QDir::temp().absoluteFilePath("antimicro_bench.ini"),
+                               QSettings::IniFormat);
+    settings.clear();
+
+    EventHandlerFactory *factory = EventHandlerFactory::getInstance("null");
+    factory->handler()->init();
+    NullEventHandler *nullHandler = static_cast<NullEventHandler*>(factory->handler());
+
+#if defined(WITH_UINPUT)
+    // Does not require a display connection.
+    AntKeyMapper::getInstance("uinput");
+#else
+    AntKeyMapper::getInstance(EventHandlerFactory::fallBackIdentifier());
+#endif
+
+    QMap<SDL_JoystickID, InputDevice*> *joysticks = new QMap<SDL_JoystickID, InputDevice*>();
+    BenchInputDaemon *daemon = new BenchInputDaemon(joysticks, &settings);
+
+    if (!options.checkName.isEmpty())
+    {
+        bool passed = true;
+        if (options.checkName == "stick-edges")
+        {
+            passed = runStickEdgeCheck(daemon, &settings, outstream);
+        }
+#if defined(WITH_EVDEV) && defined(WITH_UINPUT)
+        else if (options.checkName == "evdev-uinput")
+        {
+            BenchEvdevCheck check(&settings);
+            passed = check.run(outstream);
+        }
+#endif
+
+        delete daemon;
+        daemon = 0;
+
+        qDeleteAll(*joysticks);
+        joysticks->clear();
+        delete joysticks;
+        joysticks = 0;
+
+        AntKeyMapper::getInstance()->deleteInstance();
+        factory->handler()->cleanup();
+        factory->deleteInstance();
+
+        appLogger.Log();
+
+        return passed ? 0 : 1;
+    }
+
+    BenchInputDevice *device = new BenchInputDevice(BENCH_DEVICE_ID, options.numButtons,
+                                                    options.numAxes, options.numHats,
+                                                    &settings);
+    daemon->addBenchDevice(device);
+
+    if (!options.profileLocation.isEmpty())
+    {
+        XMLConfigReader reader;
+        reader.setFileName(options.profileLocation);
+        reader.configJoystick(device);
+        if (reader.hasError())
+        {
+            errorstream << QString("Could not load profile %1: %2")
+                           .arg(options.profileLocation).arg(reader.getErrorString()) << endl;
+            return 1;
+        }
+    }
+
+    if (options.traceLocation.isEmpty())
+    {
+        buildSyntheticTrace(trace, options);
+    }
+
+    outstream << QString("Replaying %1 events in batches of %2").arg(trace.size())
+                 .arg(options.batchSize) << endl;
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+    std::clock_t cpuStart = std::clock();
+
+    QListIterator<SDL_Event> iter(trace);
+    while (iter.hasNext())
+    {
+        for (int i=0; i < options.batchSize && iter.hasNext(); i++)
+        {
+            SDL_Event event = iter.next();
+            SDL_PushEvent(&event);
+        }
+
+        daemon->processPendingEvents();
+
+        // Stand in for the mouse timer and any zero interval timers
+        // queued by the processed buttons.
+        JoyButton::getMouseHelper()->mouseEvent();
+        a.processEvents();
+    }
+
+    std::clock_t cpuEnd = std::clock();
+    qint64 wallNsecs = wallTimer.nsecsElapsed();
+
+    double cpuSeconds = static_cast<double>(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+    double wallSeconds = wallNsecs / 1000000000.0;
+    int numEvents = qMax(1, trace.size());
+
+    outstream << endl;
+    outstream << QString("Wall time:              %1 s").arg(wallSeconds, 0, 'f', 3) << endl;
+    outstream << QString("CPU time:               %1 s").arg(cpuSeconds, 0, 'f', 3) << endl;
+    outstream << QString("Events/second:          %1").arg(trace.size() / qMax(wallSeconds, 0.000001), 0, 'f', 0) << endl;
+    outstream << QString("CPU time per event:     %1 us").arg((cpuSeconds * 1000000.0) / numEvents, 0, 'f', 3) << endl;
+    outstream << QString("Keyboard events:        %1").arg(nullHandler->getKeyboardEventCount()) << endl;
+    outstream << QString("Mouse button events:    %1").arg(nullHandler->getMouseButtonEventCount()) << endl;
+    outstream << QString("Mouse movement events:  %1").arg(nullHandler->getMouseEventCount()) << endl;
+
+    device->getActiveSetJoystick()->release();
+
+    delete daemon;
+    daemon = 0;
+
+    // Also removes any real controllers picked up while SDL was opened.
+    qDeleteAll(*joysticks);
+    joysticks->clear();
+    device = 0;
+
+    delete joysticks;
+    joysticks = 0;
+
+    AntKeyMapper::getInstance()->deleteInstance();
+    factory->handler()->cleanup();
+    factory->deleteInstance();
+
+    appLogger.Log();
+
+    return 0;
+}
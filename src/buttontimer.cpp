@@ -0,0 +1,88 @@
+#include <QObject>
+#include <QMetaObject>
+
+#include "buttontimer.h"
+#include "buttontimerwheel.h"
+
+ButtonTimer::ButtonTimer()
+{
+    receiver = 0;
+    methodIndex = -1;
+    timerInterval = 0;
+    singleShot = false;
+    expiry = 0;
+    previous = 0;
+    next = 0;
+    list = 0;
+}
+
+ButtonTimer::~ButtonTimer()
+{
+    stop();
+}
+
+/**
+ * @brief Set the slot that will be invoked when the timer expires.
+ *     Mirrors connecting the timeout signal of a QTimer.
+ * @param Object owning the slot
+ * @param Slot signature as produced by the SLOT macro
+ */
+void ButtonTimer::setReceiver(QObject *receiver, const char *member)
+{
+    this->receiver = receiver;
+    methodIndex = -1;
+
+    if (receiver && member)
+    {
+        // Skip the method type code prepended by the SLOT macro.
+        QByteArray signature = QMetaObject::normalizedSignature(member + 1);
+        methodIndex = receiver->metaObject()->indexOfMethod(signature.constData());
+    }
+}
+
+void ButtonTimer::start()
+{
+    ButtonTimerWheel::getInstance()->schedule(this, timerInterval);
+}
+
+/**
+ * @brief Start or restart the timer. An interval of 0 fires the timer
+ *     on the next pass through the event loop like a QTimer would.
+ * @param Interval in milliseconds
+ */
+void ButtonTimer::start(int msec)
+{
+    timerInterval = msec;
+    ButtonTimerWheel::getInstance()->schedule(this, timerInterval);
+}
+
+void ButtonTimer::stop()
+{
+    if (list)
+    {
+        ButtonTimerWheel::getInstance()->cancel(this);
+    }
+}
+
+void ButtonTimer::setInterval(int msec)
+{
+    timerInterval = msec;
+    if (list)
+    {
+        ButtonTimerWheel::getInstance()->schedule(this, timerInterval);
+    }
+}
+
+void ButtonTimer::setSingleShot(bool singleShot)
+{
+    this->singleShot = singleShot;
+}
+
+void ButtonTimer::timeout()
+{
+    if (receiver && methodIndex >= 0)
+    {
+        void *args[] = {0};
+        QMetaObject::metacall(receiver, QMetaObject::InvokeMetaMethod, methodIndex, args);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef BUTTONTIMER_H
+#define BUTTONTIMER_H
+
+#include <QtGlobal>
+
+class QObject;
+class ButtonTimerWheel;
+
+/**
+ * @brief Lightweight replacement for QTimer used by the button slot engine.
+ *     Timers are not QObjects and do not register with the Qt event
+ *     dispatcher. They are scheduled into a shared ButtonTimerWheel which
+ *     invokes the receiving slot when a timer expires. The public interface
+ *     follows the subset of QTimer used by JoyButton.
+ */
+class ButtonTimer
+{
+public:
+    explicit ButtonTimer();
+    ~ButtonTimer();
+
+    void setReceiver(QObject *receiver, const char *member);
+    void start();
+    void start(int msec);
+    void stop();
+    void setInterval(int msec);
+    void setSingleShot(bool singleShot);
+
+    inline bool isActive() const
+    {
+        return list != 0;
+    }
+
+    inline int interval() const
+    {
+        return timerInterval;
+    }
+
+    inline bool isSingleShot() const
+    {
+        return singleShot;
+    }
+
+protected:
+    void timeout();
+
+    QObject *receiver;
+    int methodIndex;
+    int timerInterval;
+    bool singleShot;
+
+    // Wheel bookkeeping. Timers are linked into intrusive lists so
+    // scheduling and cancelling never allocate.
+    qint64 expiry;
+    ButtonTimer *previous;
+    ButtonTimer *next;
+    ButtonTimer **list;
+
+    friend class ButtonTimerWheel;
+
+private:
+    Q_DISABLE_COPY(ButtonTimer)
+};
+
+#endif // BUTTONTIMER_H
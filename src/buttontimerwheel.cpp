@@ -0,0 +1,365 @@
+//#include <QDebug>
+#include <cstring>
+
+#include "buttontimerwheel.h"
+#include "buttontimer.h"
+
+const int ButtonTimerWheel::LEVELBITS;
+const int ButtonTimerWheel::WHEELSIZE;
+const int ButtonTimerWheel::NUMLEVELS;
+
+ButtonTimerWheel ButtonTimerWheel::wheelInstance;
+
+ButtonTimerWheel::ButtonTimerWheel(QObject *parent) :
+    QObject(parent)
+{
+    memset(wheel, 0, sizeof(wheel));
+    memset(levelCounts, 0, sizeof(levelCounts));
+    expired = 0;
+    firing = 0;
+    activeCount = 0;
+    currentTick = 0;
+    driverExpiry = -1;
+    dispatching = false;
+
+    clock.start();
+
+    driverTimer.setSingleShot(true);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+    driverTimer.setTimerType(Qt::PreciseTimer);
+#endif
+    connect(&driverTimer, SIGNAL(timeout()), this, SLOT(dispatch()));
+}
+
+ButtonTimerWheel* ButtonTimerWheel::getInstance()
+{
+    return &wheelInstance;
+}
+
+/**
+ * @brief Schedule a timer to expire after the given interval. A timer
+ *     that is already scheduled is moved to its new expiry.
+ * @param Timer to schedule
+ * @param Interval in milliseconds
+ */
+void ButtonTimerWheel::schedule(ButtonTimer *timer, int msec)
+{
+    if (timer->list)
+    {
+        unlink(timer);
+        activeCount--;
+    }
+
+    qint64 now = clock.elapsed();
+    if (activeCount == 0 && !dispatching)
+    {
+        // Nothing is pending so the wheel can jump to the present.
+        currentTick = now;
+    }
+
+    timer->expiry = now + qMax(0, msec);
+    insert(timer);
+    activeCount++;
+
+    if (!dispatching && (!driverTimer.isActive() || timer->expiry < driverExpiry))
+    {
+        scheduleDriver();
+    }
+}
+
+void ButtonTimerWheel::cancel(ButtonTimer *timer)
+{
+    if (timer->list)
+    {
+        unlink(timer);
+        activeCount--;
+    }
+
+    if (activeCount == 0 && !dispatching)
+    {
+        driverTimer.stop();
+    }
+}
+
+int ButtonTimerWheel::activeTimerCount()
+{
+    return activeCount;
+}
+
+/**
+ * @brief Place a timer in the level whose range covers the time left
+ *     until it expires. Timers that are already due are queued to fire.
+ * @param Timer to insert
+ */
+void ButtonTimerWheel::insert(ButtonTimer *timer)
+{
+    qint64 delta = timer->expiry - currentTick;
+    if (delta < 0)
+    {
+        link(&expired, timer);
+        return;
+    }
+
+    int level = 0;
+    while (level < NUMLEVELS - 1 && delta >= (Q_INT64_C(1) << (LEVELBITS * (level + 1))))
+    {
+        level++;
+    }
+
+    qint64 slotTick = timer->expiry;
+    qint64 maxDelta = (Q_INT64_C(1) << (LEVELBITS * NUMLEVELS)) - 1;
+    if (delta > maxDelta)
+    {
+        // Beyond the range of the wheel. The timer will be placed again
+        // once it cascades out of the last level.
+        slotTick = currentTick + maxDelta;
+    }
+
+    int index = (slotTick >> (LEVELBITS * level)) & (WHEELSIZE - 1);
+    link(&wheel[level][index], timer);
+    levelCounts[level]++;
+}
+
+/**
+ * @brief Append a timer to a circular list. The head keeps a pointer
+ *     to the tail through its previous link.
+ */
+void ButtonTimerWheel::link(ButtonTimer **list, ButtonTimer *timer)
+{
+    ButtonTimer *head = *list;
+    if (!head)
+    {
+        timer->next = timer;
+        timer->previous = timer;
+        *list = timer;
+    }
+    else
+    {
+        ButtonTimer *tail = head->previous;
+        tail->next = timer;
+        timer->previous = tail;
+        timer->next = head;
+        head->previous = timer;
+    }
+
+    timer->list = list;
+}
+
+void ButtonTimerWheel::unlink(ButtonTimer *timer)
+{
+    ButtonTimer **list = timer->list;
+    ButtonTimer **wheelStart = &wheel[0][0];
+    if (list >= wheelStart && list < wheelStart + (NUMLEVELS * WHEELSIZE))
+    {
+        levelCounts[(list - wheelStart) / WHEELSIZE]--;
+    }
+
+    if (timer->next == timer)
+    {
+        *list = 0;
+    }
+    else
+    {
+        timer->previous->next = timer->next;
+        timer->next->previous = timer->previous;
+        if (*list == timer)
+        {
+            *list = timer->next;
+        }
+    }
+
+    timer->next = 0;
+    timer->previous = 0;
+    timer->list = 0;
+}
+
+/**
+ * @brief Move the timers of the current slot of a level down to the
+ *     levels below it.
+ * @param Level to cascade
+ */
+void ButtonTimerWheel::cascade(int level)
+{
+    int index = (currentTick >> (LEVELBITS * level)) & (WHEELSIZE - 1);
+    while (wheel[level][index])
+    {
+        ButtonTimer *timer = wheel[level][index];
+        unlink(timer);
+        insert(timer);
+    }
+}
+
+/**
+ * @brief Process every tick up to and including the current time. Timers
+ *     expiring in that range are moved to the expired list.
+ * @param Current time in milliseconds
+ */
+void ButtonTimerWheel::advance(qint64 now)
+{
+    while (currentTick <= now)
+    {
+        bool wheelEmpty = true;
+        for (int i = 0; i < NUMLEVELS && wheelEmpty; i++)
+        {
+            wheelEmpty = levelCounts[i] == 0;
+        }
+
+        if (wheelEmpty)
+        {
+            currentTick = now + 1;
+            break;
+        }
+
+        int index = currentTick & (WHEELSIZE - 1);
+        if (index == 0)
+        {
+            // Find the highest level that starts a new slot at this
+            // tick and cascade downwards from there.
+            int level = 1;
+            while (level < NUMLEVELS - 1 &&
+                   ((currentTick >> (LEVELBITS * level)) & (WHEELSIZE - 1)) == 0)
+            {
+                level++;
+            }
+
+            for (; level >= 1; level--)
+            {
+                cascade(level);
+            }
+        }
+
+        while (wheel[0][index])
+        {
+            ButtonTimer *timer = wheel[0][index];
+            unlink(timer);
+            link(&expired, timer);
+        }
+
+        if (levelCounts[0] == 0)
+        {
+            // Skip ahead to the next cascade.
+            qint64 nextSlotStart = (currentTick | (WHEELSIZE - 1)) + 1;
+            currentTick = qMin(nextSlotStart, now + 1);
+        }
+        else
+        {
+            currentTick++;
+        }
+    }
+}
+
+/**
+ * @brief Find the earliest tick at which work is pending. This is either
+ *     the expiry of a timer in the lowest level or the next cascade of
+ *     a non-empty slot in a higher level.
+ * @return Tick in milliseconds. -1 if no timers are scheduled.
+ */
+qint64 ButtonTimerWheel::nextExpiry()
+{
+    if (expired)
+    {
+        return currentTick - 1;
+    }
+
+    qint64 result = -1;
+    if (levelCounts[0] > 0)
+    {
+        for (int i = 0; i < WHEELSIZE && result == -1; i++)
+        {
+            if (wheel[0][(currentTick + i) & (WHEELSIZE - 1)])
+            {
+                result = currentTick + i;
+            }
+        }
+    }
+
+    for (int level = 1; level < NUMLEVELS; level++)
+    {
+        if (levelCounts[level] > 0)
+        {
+            int shift = LEVELBITS * level;
+            qint64 currentSlot = currentTick >> shift;
+            // The cascade of the current slot has not happened yet if the
+            // current tick is at the start of it.
+            int first = ((currentSlot << shift) == currentTick) ? 0 : 1;
+            for (int i = first; i < WHEELSIZE + first; i++)
+            {
+                if (wheel[level][(currentSlot + i) & (WHEELSIZE - 1)])
+                {
+                    qint64 cascadeTick = (currentSlot + i) << shift;
+                    if (result == -1 || cascadeTick < result)
+                    {
+                        result = cascadeTick;
+                    }
+
+                    break;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void ButtonTimerWheel::scheduleDriver()
+{
+    qint64 next = nextExpiry();
+    if (next < 0 && !expired)
+    {
+        driverTimer.stop();
+        driverExpiry = -1;
+    }
+    else
+    {
+        qint64 delay = qMax(Q_INT64_C(0), next - clock.elapsed());
+        driverExpiry = next;
+        driverTimer.start(static_cast<int>(delay));
+    }
+}
+
+/**
+ * @brief Fire every timer that has expired. Repeating timers are placed
+ *     back into the wheel before their slot is invoked. Timers started
+ *     from within a slot fire on a later pass at the earliest.
+ */
+void ButtonTimerWheel::dispatch()
+{
+    dispatching = true;
+
+    qint64 now = clock.elapsed();
+    advance(now);
+
+    // Move the expired timers aside so that timers expiring again while
+    // slots run are left for the next pass.
+    while (expired)
+    {
+        ButtonTimer *timer = expired;
+        unlink(timer);
+        link(&firing, timer);
+    }
+
+    while (firing)
+    {
+        ButtonTimer *timer = firing;
+        unlink(timer);
+        activeCount--;
+
+        if (!timer->singleShot)
+        {
+            qint64 nextExpiry = timer->expiry + timer->timerInterval;
+            if (nextExpiry <= now)
+            {
+                nextExpiry = now + timer->timerInterval;
+            }
+
+            timer->expiry = nextExpiry;
+            insert(timer);
+            activeCount++;
+        }
+
+        timer->timeout();
+    }
+
+    dispatching = false;
+    scheduleDriver();
+}
@@ -0,0 +1,65 @@
+#ifndef BUTTONTIMERWHEEL_H
+#define BUTTONTIMERWHEEL_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class ButtonTimer;
+
+/**
+ * @brief Hierarchical timer wheel that drives every ButtonTimer with a
+ *     single QTimer. Time is tracked in milliseconds. Each level holds
+ *     WHEELSIZE slots and covers WHEELSIZE times the range of the level
+ *     below it. Timers are moved down a level as their expiry
+ *     approaches so scheduling, cancelling and firing are O(1).
+ */
+class ButtonTimerWheel : public QObject
+{
+    Q_OBJECT
+public:
+    static ButtonTimerWheel* getInstance();
+
+    void schedule(ButtonTimer *timer, int msec);
+    void cancel(ButtonTimer *timer);
+    int activeTimerCount();
+
+    static const int LEVELBITS = 6;
+    static const int WHEELSIZE = 1 << LEVELBITS;
+    static const int NUMLEVELS = 4;
+
+protected:
+    explicit ButtonTimerWheel(QObject *parent = 0);
+
+    void insert(ButtonTimer *timer);
+    void link(ButtonTimer **list, ButtonTimer *timer);
+    void unlink(ButtonTimer *timer);
+    void cascade(int level);
+    void advance(qint64 now);
+    qint64 nextExpiry();
+    void scheduleDriver();
+
+    ButtonTimer *wheel[NUMLEVELS][WHEELSIZE];
+    int levelCounts[NUMLEVELS];
+    // Timers that have expired and are waiting to be fired.
+    ButtonTimer *expired;
+    // Timers being fired by the current dispatch.
+    ButtonTimer *firing;
+    int activeCount;
+    // Next tick that has not been processed yet.
+    qint64 currentTick;
+    qint64 driverExpiry;
+    bool dispatching;
+
+    QElapsedTimer clock;
+    QTimer driverTimer;
+
+    static ButtonTimerWheel wheelInstance;
+
+signals:
+
+private slots:
+    void dispatch();
+};
+
+#endif // BUTTONTIMERWHEEL_H
@@ -28,6 +28,15 @@ QRegExp CommandLineUtility::mappingRegexp = QRegExp("--map");
 QRegExp CommandLineUtility::qtStyleRegexp = QRegExp("-style");
 QRegExp CommandLineUtility::logLevelRegexp = QRegExp("--log-level");
 QRegExp CommandLineUtility::eventgenRegexp = QRegExp("--eventgen");
+QRegExp CommandLineUtility::inputThreadRegexp = QRegExp("--input-thread");
+QRegExp CommandLineUtility::latencyReportRegexp = QRegExp("--latency-report");
+QRegExp CommandLineUtility::recordInputRegexp = QRegExp("--record-input");
+QRegExp CommandLineUtility::replayInputRegexp = QRegExp("--replay-input");
+QRegExp CommandLineUtility::replaySpeedRegexp = QRegExp("--replay-speed");
+
+#ifdef WITH_EVDEV
+QRegExp CommandLineUtility::evdevRegexp = QRegExp("--evdev");
+#endif
 
 #ifdef Q_OS_UNIX
 QRegExp CommandLineUtility::daemonRegexp = QRegExp("--daemon|-d");
@@ -57,6 +66,10 @@ CommandLineUtility::CommandLineUtility(QObject *parent) :
     listControllers = false;
     mappingController = false;
     currentLogLevel = Logger::LOG_INFO;
+    inputThreadRequest = false;
+    latencyReportRequest = false;
+    evdevRequest = false;
+    replaySpeed = 1.0;
 
     eventGenerator = EventHandlerFactory::fallBackIdentifier();
 }
@@ -143,6 +156,73 @@ void CommandLineUtility::parseArguments(QStringList& arguments)
         {
             hiddenRequest = true;
         }
+        else if (inputThreadRegexp.exactMatch(temp))
+        {
+            inputThreadRequest = true;
+        }
+        else if (latencyReportRegexp.exactMatch(temp))
+        {
+            latencyReportRequest = true;
+        }
+#ifdef WITH_EVDEV
+        else if (evdevRegexp.exactMatch(temp))
+        {
+            evdevRequest = true;
+        }
+#endif
+        else if (recordInputRegexp.exactMatch(temp))
+        {
+            if (iter.hasNext())
+            {
+                recordInputLocation = QFileInfo(iter.next()).absoluteFilePath();
+            }
+            else
+            {
+                setErrorMessage(tr("No input trace file was specified."));
+            }
+        }
+        else if (replayInputRegexp.exactMatch(temp))
+        {
+            if (iter.hasNext())
+            {
+                temp = iter.next();
+                QFileInfo fileInfo(temp);
+                if (fileInfo.exists())
+                {
+                    replayInputLocation = fileInfo.absoluteFilePath();
+                }
+                else
+                {
+                    setErrorMessage(tr("Input trace %1 does not exist.").arg(temp));
+                }
+            }
+            else
+            {
+                setErrorMessage(tr("No input trace file was specified."));
+            }
+        }
+        else if (replaySpeedRegexp.exactMatch(temp))
+        {
+            if (iter.hasNext())
+            {
+                temp = iter.next();
+
+                bool validNumber = false;
+                double tempSpeed = temp.toDouble(&validNumber);
+                if (validNumber && tempSpeed >= 0.0)
+                {
+                    replaySpeed = tempSpeed;
+                }
+                else
+                {
+                    setErrorMessage(tr("An invalid replay speed was specified."));
+                }
+            }
+            else
+            {
+                setErrorMessage(tr("No replay speed was specified."));
+            }
+        }
         else if (unloadRegexp.exactMatch(temp))
         {
             unloadProfile = true;
@@ -444,6 +524,31 @@ void CommandLineUtility::printHelp()
         << endl;
     out << "--startSet <number> [<value>] " << " " << tr("Start joysticks on a specific set.   \n                               Value can be a controller index, name, or GUID.")
         << endl;
+    out << "--input-thread                " << " "
+        << tr("Drain SDL events on the dedicated input thread\n"
+              "                               and hand them over in batches.")
+        << endl;
+    out << "--latency-report              " << " "
+        << tr("Trace input latency from SDL to the event\n"
+              "                               generator and print a report on exit.")
+        << endl;
+    out << "--record-input <location>     " << " "
+        << tr("Record raw controller input to a trace file.")
+        << endl;
+    out << "--replay-input <location>     " << " "
+        << tr("Replay a recorded input trace on the\n"
+              "                               connected controllers.")
+        << endl;
+    out << "--replay-speed <value>        " << " "
+        << tr("Speed factor used when replaying a trace.\n"
+              "                               Use 0 to replay as fast as possible.")
+        << endl;
+#ifdef WITH_EVDEV
+    out << "--evdev                       " << " "
+        << tr("Read controller input directly from evdev\n"
+              "                               instead of SDL. Experimental.")
+        << endl;
+#endif
 #ifdef Q_OS_UNIX
     out << "-d, --daemon                  " << " "
         << tr("Launch program as a daemon.") << endl;
@@ -512,6 +617,31 @@ QString CommandLineUtility::generateHelpString()
         << endl;
     out << "--startSet <number> [<value>] " << " " << tr("Start joysticks on a specific set.   \n                               Value can be a controller index, name, or GUID.")
         << endl;
+    out << "--input-thread                " << " "
+        << tr("Drain SDL events on the dedicated input thread\n"
+              "                               and hand them over in batches.")
+        << endl;
+    out << "--latency-report              " << " "
+        << tr("Trace input latency from SDL to the event\n"
+              "                               generator and print a report on exit.")
+        << endl;
+    out << "--record-input <location>     " << " "
+        << tr("Record raw controller input to a trace file.")
+        << endl;
+    out << "--replay-input <location>     " << " "
+        << tr("Replay a recorded input trace on the\n"
+              "                               connected controllers.")
+        << endl;
+    out << "--replay-speed <value>        " << " "
+        << tr("Speed factor used when replaying a trace.\n"
+              "                               Use 0 to replay as fast as possible.")
+        << endl;
+#ifdef WITH_EVDEV
+    out << "--evdev                       " << " "
+        << tr("Read controller input directly from evdev\n"
+              "                               instead of SDL. Experimental.")
+        << endl;
+#endif
 #ifdef Q_OS_UNIX
     out << "-d, --daemon                  " << " "
         << tr("Launch program as a daemon.") << endl;
@@ -617,6 +747,48 @@ bool CommandLineUtility::isHiddenRequested()
     return hiddenRequest;
 }
 
+bool CommandLineUtility::isInputThreadRequested()
+{
+    return inputThreadRequest;
+}
+
+bool CommandLineUtility::isLatencyReportRequested()
+{
+    return latencyReportRequest;
+}
+
+#ifdef WITH_EVDEV
+bool CommandLineUtility::isEvdevInputRequested()
+{
+    return evdevRequest;
+}
+#endif
+
+bool CommandLineUtility::hasRecordInputLocation()
+{
+    return !recordInputLocation.isEmpty();
+}
+
+QString CommandLineUtility::getRecordInputLocation()
+{
+    return recordInputLocation;
+}
+
+bool CommandLineUtility::hasReplayInputLocation()
+{
+    return !replayInputLocation.isEmpty();
+}
+
+QString CommandLineUtility::getReplayInputLocation()
+{
+    return replayInputLocation;
+}
+
+double CommandLineUtility::getReplaySpeed()
+{
+    return replaySpeed;
+}
+
 bool CommandLineUtility::hasControllerID()
 {
     return !controllerIDString.isEmpty();
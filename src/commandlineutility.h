@@ -26,6 +26,16 @@ public:
     unsigned int getControllerNumber();
     QString getControllerID();
     bool isHiddenRequested();
+    bool isInputThreadRequested();
+    bool isLatencyReportRequested();
+#ifdef WITH_EVDEV
+    bool isEvdevInputRequested();
+#endif
+    bool hasRecordInputLocation();
+    QString getRecordInputLocation();
+    bool hasReplayInputLocation();
+    QString getReplayInputLocation();
+    double getReplaySpeed();
     bool isUnloadRequested();
     bool shouldListControllers();
     bool shouldMapController();
@@ -71,6 +81,12 @@ protected:
     bool mappingController;
     QString eventGenerator;
     QString errorText;
+    bool inputThreadRequest;
+    bool latencyReportRequest;
+    bool evdevRequest;
+    QString recordInputLocation;
+    QString replayInputLocation;
+    double replaySpeed;
     Logger::LogLevel currentLogLevel;
 
     static QRegExp trayRegexp;
@@ -87,6 +103,14 @@ protected:
     static QRegExp qtStyleRegexp;
     static QRegExp logLevelRegexp;
     static QRegExp eventgenRegexp;
+    static QRegExp inputThreadRegexp;
+    static QRegExp latencyReportRegexp;
+    static QRegExp recordInputRegexp;
+    static QRegExp replayInputRegexp;
+    static QRegExp replaySpeedRegexp;
+#ifdef WITH_EVDEV
+    static QRegExp evdevRegexp;
+#endif
     static QStringList eventGeneratorsList;
 
 #ifdef Q_OS_UNIX
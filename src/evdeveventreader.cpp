@@ -0,0 +1,1024 @@
+//#include <QDebug>
+#include <QDir>
+#include <QMutexLocker>
+#include <QHashIterator>
+#include <QListIterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <linux/input.h>
+
+#include "evdeveventreader.h"
+#include "gamecontroller/gamecontroller.h"
+
+const int EvdevEventReader::MAXREADEVENTS = 64;
+const int EvdevEventReader::MAXEPOLLEVENTS = 16;
+
+static const int LONGBITS = sizeof(unsigned long) * 8;
+
+static inline bool testBit(const unsigned long *bits, int bit)
+{
+    return (bits[bit / LONGBITS] >> (bit % LONGBITS)) & 1UL;
+}
+
+// SDL hat values indexed by the vertical and horizontal direction.
+static const int hatPositions[3][3] = {
+    {SDL_HAT_LEFTUP, SDL_HAT_UP, SDL_HAT_RIGHTUP},
+    {SDL_HAT_LEFT, SDL_HAT_CENTERED, SDL_HAT_RIGHT},
+    {SDL_HAT_LEFTDOWN, SDL_HAT_DOWN, SDL_HAT_RIGHTDOWN}
+};
+
+EvdevEventReader::EvdevEventReader(QObject *parent) :
+    QObject(parent)
+{
+    eventsQueued = false;
+    removeAllRequested = false;
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (epollFd >= 0 && wakeFd >= 0)
+    {
+        struct epoll_event wakeEvent;
+        memset(&wakeEvent, 0, sizeof(wakeEvent));
+        wakeEvent.events = EPOLLIN;
+        wakeEvent.data.fd = wakeFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent);
+    }
+}
+
+/**
+ * @brief Close all device nodes. The reader thread must have finished.
+ */
+EvdevEventReader::~EvdevEventReader()
+{
+    applyCommands();
+
+    QHashIterator<int, EvdevDevice*> iter(devices);
+    while (iter.hasNext())
+    {
+        closeDevice(iter.next().value());
+    }
+
+    devices.clear();
+
+    if (wakeFd >= 0)
+    {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+        epollFd = -1;
+    }
+}
+
+bool EvdevEventReader::isOpen()
+{
+    return epollFd >= 0 && wakeFd >= 0;
+}
+
+/**
+ * @brief Find the evdev node of a device opened through SDL and start
+ *     reading it. Called from the GUI thread.
+ * @param Device opened through SDL
+ * @return Whether input of the device is now read through evdev. SDL keeps
+ *     handling the device otherwise.
+ */
+bool EvdevEventReader::addDevice(InputDevice *device)
+{
+    bool result = false;
+
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+    SDL_JoystickID deviceID = device->getSDLJoystickID();
+    SDL_Joystick *joyhandle = SDL_JoystickFromInstanceID(deviceID);
+
+    if (isOpen() && joyhandle && !devicePaths.contains(deviceID))
+    {
+        EvdevDevice *evdevDevice = openDevice(joyhandle);
+        if (evdevDevice && device->isGameController() &&
+            !buildControllerBinds(evdevDevice, device))
+        {
+            closeDevice(evdevDevice);
+            evdevDevice = 0;
+        }
+
+        if (evdevDevice)
+        {
+            evdevDevice->deviceID = deviceID;
+            devicePaths.insert(deviceID, evdevDevice->path);
+
+            commandMutex.lock();
+            addedDevices.append(evdevDevice);
+            commandMutex.unlock();
+
+            wakeReader();
+            result = true;
+        }
+    }
+#else
+    Q_UNUSED(device);
+#endif
+
+    return result;
+}
+
+/**
+ * @brief Stop reading a device. Called from the GUI thread.
+ * @param SDL instance ID of the device
+ */
+void EvdevEventReader::removeDevice(SDL_JoystickID deviceID)
+{
+    if (devicePaths.contains(deviceID))
+    {
+        devicePaths.remove(deviceID);
+
+        QMutexLocker locker(&commandMutex);
+        bool pendingAdd = false;
+
+        QMutableListIterator<EvdevDevice*> iter(addedDevices);
+        while (iter.hasNext() && !pendingAdd)
+        {
+            EvdevDevice *device = iter.next();
+            if (device->deviceID == deviceID)
+            {
+                iter.remove();
+                closeDevice(device);
+                pendingAdd = true;
+            }
+        }
+
+        if (!pendingAdd)
+        {
+            removedDevices.append(deviceID);
+            locker.unlock();
+            wakeReader();
+        }
+    }
+}
+
+/**
+ * @brief Stop reading all devices. Called from the GUI thread.
+ */
+void EvdevEventReader::removeAllDevices()
+{
+    devicePaths.clear();
+
+    commandMutex.lock();
+    QListIterator<EvdevDevice*> iter(addedDevices);
+    while (iter.hasNext())
+    {
+        closeDevice(iter.next());
+    }
+
+    addedDevices.clear();
+    removedDevices.clear();
+    removeAllRequested = true;
+    commandMutex.unlock();
+
+    wakeReader();
+}
+
+/**
+ * @brief Hand all events gathered by the reader thread over to the caller.
+ *     Must only be called from the thread that receives eventRaised.
+ * @param Queue that will receive the buffered events
+ */
+void EvdevEventReader::takeEvents(QQueue<SDL_Event> *events)
+{
+    // Clear the flag first so events added while taking the batch raise
+    // another notification.
+    notifyPending.fetchAndStoreOrdered(0);
+
+    SDL_Event event;
+    while (pendingEvents.dequeue(&event))
+    {
+        events->enqueue(event);
+    }
+}
+
+/**
+ * @brief Ask the reader loop to return. Safe to call from any thread.
+ */
+void EvdevEventReader::stop()
+{
+    stopRequested.fetchAndStoreOrdered(1);
+    wakeReader();
+}
+
+/**
+ * @brief Reader loop. Blocks in epoll until a device has input or the GUI
+ *     thread changed the device list, and returns once stop is requested.
+ */
+void EvdevEventReader::performWork()
+{
+    struct epoll_event readyEvents[MAXEPOLLEVENTS];
+
+    while (stopRequested.fetchAndAddOrdered(0) == 0)
+    {
+        int count = epoll_wait(epollFd, readyEvents, MAXEPOLLEVENTS, -1);
+
+        applyCommands();
+
+        for (int i=0; i < count; i++)
+        {
+            int fd = readyEvents[i].data.fd;
+            if (fd == wakeFd)
+            {
+                quint64 counter = 0;
+                ssize_t status = read(wakeFd, &counter, sizeof(counter));
+                Q_UNUSED(status);
+            }
+            else if (devices.contains(fd))
+            {
+                readDevice(devices.value(fd));
+            }
+        }
+
+        notifyEvents();
+    }
+}
+
+void EvdevEventReader::wakeReader()
+{
+    if (wakeFd >= 0)
+    {
+        quint64 counter = 1;
+        ssize_t status = write(wakeFd, &counter, sizeof(counter));
+        Q_UNUSED(status);
+    }
+}
+
+/**
+ * @brief Notify the GUI thread about new events. It is only notified when
+ *     it has no wakeup pending so a burst of events costs a single cross
+ *     thread wakeup.
+ */
+void EvdevEventReader::notifyEvents()
+{
+    if (eventsQueued)
+    {
+        eventsQueued = false;
+        if (notifyPending.testAndSetOrdered(0, 1))
+        {
+            emit eventRaised();
+        }
+    }
+}
+
+/**
+ * @brief Find the evdev node SDL reads a device from. The node path is
+ *     taken from SDL when it reports one. Otherwise nodes are matched by
+ *     the bus, vendor, product and version stored in the SDL GUID. Without
+ *     a path from SDL, identical devices cannot be told apart and are left
+ *     to SDL.
+ * @param SDL joystick handle
+ * @return Configured device or NULL if no usable node was found
+ */
+EvdevEventReader::EvdevDevice* EvdevEventReader::openDevice(SDL_Joystick *joyhandle)
+{
+    EvdevDevice *result = 0;
+
+    SDL_JoystickGUID guid = SDL_JoystickGetGUID(joyhandle);
+    unsigned int bustype = guid.data[0] | (guid.data[1] << 8);
+    unsigned int vendor = guid.data[4] | (guid.data[5] << 8);
+    unsigned int product = guid.data[8] | (guid.data[9] << 8);
+    unsigned int version = guid.data[12] | (guid.data[13] << 8);
+
+    // A GUID without a vendor holds the device name instead. A non zero
+    // driver signature marks devices SDL reads through another driver
+    // with its own element numbering.
+    bool evdevGUID = vendor != 0 && guid.data[14] == 0;
+
+    if (evdevGUID)
+    {
+        QStringList nodePaths;
+
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+        const char *joystickPath = SDL_JoystickPath(joyhandle);
+        if (joystickPath && QString(joystickPath).startsWith("/dev/input/event"))
+        {
+            nodePaths.append(QString::fromLocal8Bit(joystickPath));
+        }
+#endif
+
+        if (nodePaths.isEmpty())
+        {
+            QDir inputDir("/dev/input");
+            QStringList nodeNames = inputDir.entryList(QStringList("event*"), QDir::System);
+            QStringListIterator nameIter(nodeNames);
+            while (nameIter.hasNext())
+            {
+                nodePaths.append(inputDir.absoluteFilePath(nameIter.next()));
+            }
+        }
+
+        QList<EvdevDevice*> candidates;
+
+        QStringListIterator iter(nodePaths);
+        while (iter.hasNext())
+        {
+            QString path = iter.next();
+            QByteArray tempPath = path.toLocal8Bit();
+            int fd = open(tempPath.constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if (fd < 0)
+            {
+                continue;
+            }
+
+            struct input_id inputID;
+            memset(&inputID, 0, sizeof(inputID));
+            bool matched = ioctl(fd, EVIOCGID, &inputID) >= 0 &&
+                    inputID.bustype == bustype && inputID.vendor == vendor &&
+                    inputID.product == product && inputID.version == version;
+
+            if (matched)
+            {
+                EvdevDevice *device = new EvdevDevice;
+                device->fd = fd;
+                device->path = path;
+                device->deviceID = -1;
+                device->gameController = false;
+                device->dropped = false;
+
+                if (configureDevice(device) &&
+                    device->buttonMap.size() == SDL_JoystickNumButtons(joyhandle) &&
+                    device->axisMap.size() == SDL_JoystickNumAxes(joyhandle) &&
+                    device->hatMap.size() == SDL_JoystickNumHats(joyhandle))
+                {
+                    candidates.append(device);
+                }
+                else
+                {
+                    closeDevice(device);
+                }
+            }
+            else
+            {
+                close(fd);
+            }
+        }
+
+        if (candidates.size() == 1 && !devicePaths.values().contains(candidates.first()->path))
+        {
+            result = candidates.takeFirst();
+        }
+
+        QListIterator<EvdevDevice*> candidateIter(candidates);
+        while (candidateIter.hasNext())
+        {
+            closeDevice(candidateIter.next());
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Number the buttons, axes and hats of a node the way the SDL Linux
+ *     joystick driver does and read their current state.
+ * @param Device with an open node
+ * @return Whether the node has any joystick elements
+ */
+bool EvdevEventReader::configureDevice(EvdevDevice *device)
+{
+    unsigned long keyBits[(KEY_MAX / LONGBITS) + 1];
+    unsigned long absBits[(ABS_MAX / LONGBITS) + 1];
+    unsigned long keyStates[(KEY_MAX / LONGBITS) + 1];
+    memset(keyBits, 0, sizeof(keyBits));
+    memset(absBits, 0, sizeof(absBits));
+    memset(keyStates, 0, sizeof(keyStates));
+
+    if (ioctl(device->fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
+        ioctl(device->fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0)
+    {
+        return false;
+    }
+
+    ioctl(device->fd, EVIOCGKEY(sizeof(keyStates)), keyStates);
+
+    // Joystick buttons come first, followed by any other keys.
+    for (int i=BTN_JOYSTICK; i < KEY_MAX; i++)
+    {
+        if (testBit(keyBits, i))
+        {
+            device->buttonMap.insert(i, device->buttonStates.size());
+            device->buttonStates.append(testBit(keyStates, i));
+        }
+    }
+
+    for (int i=0; i < BTN_JOYSTICK; i++)
+    {
+        if (testBit(keyBits, i))
+        {
+            device->buttonMap.insert(i, device->buttonStates.size());
+            device->buttonStates.append(testBit(keyStates, i));
+        }
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Newer SDL versions only apply the flat zone reported by the
+    // device when asked to.
+    bool useFlat = SDL_GetHintBoolean("SDL_LINUX_JOYSTICK_DEADZONES", SDL_FALSE);
+#else
+    bool useFlat = true;
+#endif
+
+    for (int i=0; i < ABS_MAX; i++)
+    {
+        // Hats are numbered separately.
+        if (i == ABS_HAT0X)
+        {
+            i = ABS_HAT3Y;
+            continue;
+        }
+
+        struct input_absinfo absInfo;
+        if (testBit(absBits, i) && ioctl(device->fd, EVIOCGABS(i), &absInfo) >= 0)
+        {
+            AxisCorrection correction;
+            correction.minimum = absInfo.minimum;
+            correction.maximum = absInfo.maximum;
+            correction.useFlat = useFlat;
+            correction.coef[0] = (absInfo.maximum + absInfo.minimum) - (2 * absInfo.flat);
+            correction.coef[1] = (absInfo.maximum + absInfo.minimum) + (2 * absInfo.flat);
+
+            int range = (absInfo.maximum - absInfo.minimum) - (4 * absInfo.flat);
+            correction.coef[2] = range != 0 ? (1 << 28) / range : 0;
+
+            device->axisMap.insert(i, device->axisValues.size());
+            device->axisCorrections.append(correction);
+            device->axisValues.append(correctAxisValue(correction, absInfo.value));
+        }
+    }
+
+    for (int i=ABS_HAT0X; i <= ABS_HAT3Y; i += 2)
+    {
+        if (testBit(absBits, i) || testBit(absBits, i + 1))
+        {
+            device->hatMap.insert((i - ABS_HAT0X) / 2, device->hatValues.size());
+            device->hatX.append(0);
+            device->hatY.append(0);
+            device->hatValues.append(SDL_HAT_CENTERED);
+        }
+    }
+
+    // Take the current hat positions without reporting them.
+    QHashIterator<int, int> hatIter(device->hatMap);
+    while (hatIter.hasNext())
+    {
+        hatIter.next();
+        int hat = hatIter.value();
+        struct input_absinfo absInfo;
+        if (ioctl(device->fd, EVIOCGABS(ABS_HAT0X + (hatIter.key() * 2)), &absInfo) >= 0)
+        {
+            device->hatX[hat] = absInfo.value < 0 ? -1 : (absInfo.value > 0 ? 1 : 0);
+        }
+
+        if (ioctl(device->fd, EVIOCGABS(ABS_HAT0X + (hatIter.key() * 2) + 1), &absInfo) >= 0)
+        {
+            device->hatY[hat] = absInfo.value < 0 ? -1 : (absInfo.value > 0 ? 1 : 0);
+        }
+
+        device->hatValues[hat] = hatPositions[device->hatY.at(hat) + 1][device->hatX.at(hat) + 1];
+    }
+
+    return !device->buttonMap.isEmpty() || !device->axisMap.isEmpty() ||
+            !device->hatMap.isEmpty();
+}
+
+/**
+ * @brief Translate joystick elements to game controller elements using the
+ *     SDL mapping of the controller. SDL only reports which element a
+ *     controller element is bound to, not the range of the bind. Controllers
+ *     with half axis or inverted binds, buttons bound to joystick axes or
+ *     joystick elements bound more than once are therefore left to SDL.
+ * @param Device to fill
+ * @param Game controller opened through SDL
+ * @return Whether every bind of the controller could be translated
+ */
+bool EvdevEventReader::buildControllerBinds(EvdevDevice *device, InputDevice *inputDevice)
+{
+    GameController *controller = static_cast<GameController*>(inputDevice);
+    device->gameController = true;
+
+    bool result = !hasRangedBinds(controller->getMappingString());
+
+    for (int i=0; i < SDL_CONTROLLER_AXIS_MAX && result; i++)
+    {
+        SDL_GameControllerButtonBind bind = controller->getBindForAxis(i);
+        if (bind.bindType == SDL_CONTROLLER_BINDTYPE_AXIS)
+        {
+            result = !device->axisToControllerAxis.contains(bind.value.axis);
+            device->axisToControllerAxis.insert(bind.value.axis, i);
+        }
+        else if (bind.bindType == SDL_CONTROLLER_BINDTYPE_BUTTON)
+        {
+            // Only triggers have a defined released value.
+            result = !device->buttonToControllerAxis.contains(bind.value.button) &&
+                    (i == SDL_CONTROLLER_AXIS_TRIGGERLEFT || i == SDL_CONTROLLER_AXIS_TRIGGERRIGHT);
+            device->buttonToControllerAxis.insert(bind.value.button, i);
+        }
+        else if (bind.bindType == SDL_CONTROLLER_BINDTYPE_HAT)
+        {
+            result = false;
+        }
+    }
+
+    for (int i=0; i < SDL_CONTROLLER_BUTTON_MAX && result; i++)
+    {
+        SDL_GameControllerButtonBind bind = controller->getBindForButton(i);
+        if (bind.bindType == SDL_CONTROLLER_BINDTYPE_AXIS)
+        {
+            result = false;
+        }
+        else if (bind.bindType == SDL_CONTROLLER_BINDTYPE_BUTTON)
+        {
+            result = !device->buttonToControllerButton.contains(bind.value.button) &&
+                    !device->buttonToControllerAxis.contains(bind.value.button);
+            device->buttonToControllerButton.insert(bind.value.button, i);
+        }
+        else if (bind.bindType == SDL_CONTROLLER_BINDTYPE_HAT)
+        {
+            QListIterator<HatBind> iter(device->hatBinds);
+            while (iter.hasNext() && result)
+            {
+                const HatBind &hatBind = iter.next();
+                result = hatBind.hat != bind.value.hat.hat ||
+                        (hatBind.mask & bind.value.hat.hat_mask) == 0;
+            }
+
+            HatBind hatBind;
+            hatBind.hat = bind.value.hat.hat;
+            hatBind.mask = bind.value.hat.hat_mask;
+            hatBind.button = i;
+            device->hatBinds.append(hatBind);
+        }
+    }
+
+    device->controllerButtonStates.fill(false, SDL_CONTROLLER_BUTTON_MAX);
+
+    return result;
+}
+
+/**
+ * @brief Check a mapping string for binds that only use part of an axis
+ *     or invert it.
+ * @param SDL game controller mapping string
+ * @return Whether the mapping has half axis or inverted binds
+ */
+bool EvdevEventReader::hasRangedBinds(const QString &mapping)
+{
+    bool result = false;
+
+    // The GUID and the name come before the binds.
+    QStringList fields = mapping.split(",", QString::SkipEmptyParts);
+    for (int i=2; i < fields.size() && !result; i++)
+    {
+        QString target = fields.at(i).section(':', 0, 0).trimmed();
+        QString source = fields.at(i).section(':', 1).trimmed();
+        result = target.startsWith('+') || target.startsWith('-') ||
+                source.startsWith('+') || source.startsWith('-') ||
+                source.endsWith('~');
+    }
+
+    return result;
+}
+
+void EvdevEventReader::closeDevice(EvdevDevice *device)
+{
+    if (device->fd >= 0)
+    {
+        if (epollFd >= 0)
+        {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, device->fd, 0);
+        }
+
+        close(device->fd);
+        device->fd = -1;
+    }
+
+    delete device;
+}
+
+/**
+ * @brief Apply device changes requested by the GUI thread.
+ */
+void EvdevEventReader::applyCommands()
+{
+    QMutexLocker locker(&commandMutex);
+
+    if (removeAllRequested)
+    {
+        QHashIterator<int, EvdevDevice*> iter(devices);
+        while (iter.hasNext())
+        {
+            closeDevice(iter.next().value());
+        }
+
+        devices.clear();
+        removeAllRequested = false;
+    }
+
+    QListIterator<EvdevDevice*> addIter(addedDevices);
+    while (addIter.hasNext())
+    {
+        EvdevDevice *device = addIter.next();
+
+        struct epoll_event deviceEvent;
+        memset(&deviceEvent, 0, sizeof(deviceEvent));
+        deviceEvent.events = EPOLLIN;
+        deviceEvent.data.fd = device->fd;
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, device->fd, &deviceEvent) == 0)
+        {
+            devices.insert(device->fd, device);
+        }
+        else
+        {
+            closeDevice(device);
+        }
+    }
+
+    addedDevices.clear();
+
+    QListIterator<SDL_JoystickID> removeIter(removedDevices);
+    while (removeIter.hasNext())
+    {
+        SDL_JoystickID deviceID = removeIter.next();
+
+        QMutableHashIterator<int, EvdevDevice*> iter(devices);
+        while (iter.hasNext())
+        {
+            EvdevDevice *device = iter.next().value();
+            if (device->deviceID == deviceID)
+            {
+                iter.remove();
+                closeDevice(device);
+            }
+        }
+    }
+
+    removedDevices.clear();
+}
+
+/**
+ * @brief Read every input_event waiting on a node. A node that went away
+ *     is closed. SDL reports the removal of the device.
+ * @param Device with pending input
+ */
+void EvdevEventReader::readDevice(EvdevDevice *device)
+{
+    struct input_event buffer[MAXREADEVENTS];
+    bool reading = true;
+    bool removed = false;
+
+    while (reading)
+    {
+        ssize_t size = read(device->fd, buffer, sizeof(buffer));
+        if (size > 0)
+        {
+            int count = size / sizeof(struct input_event);
+            for (int i=0; i < count; i++)
+            {
+                handleInputEvent(device, buffer[i]);
+            }
+        }
+        else if (size == 0 || errno != EINTR)
+        {
+            removed = size == 0 || errno != EAGAIN;
+            reading = false;
+        }
+    }
+
+    if (removed)
+    {
+        devices.remove(device->fd);
+        closeDevice(device);
+    }
+}
+
+void EvdevEventReader::handleInputEvent(EvdevDevice *device, const struct input_event &event)
+{
+    if (event.type == EV_SYN)
+    {
+        if (event.code == SYN_DROPPED)
+        {
+            device->dropped = true;
+        }
+        else if (event.code == SYN_REPORT && device->dropped)
+        {
+            device->dropped = false;
+            resyncDevice(device);
+        }
+    }
+    else if (!device->dropped)
+    {
+        if (event.type == EV_KEY)
+        {
+            updateButton(device, event.code, event.value != 0);
+        }
+        else if (event.type == EV_ABS)
+        {
+            if (event.code >= ABS_HAT0X && event.code <= ABS_HAT3Y)
+            {
+                updateHat(device, event.code, event.value);
+            }
+            else
+            {
+                updateAxis(device, event.code, event.value);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Read the full element state after the kernel dropped events and
+ *     report every element that changed.
+ * @param Device to resynchronize
+ */
+void EvdevEventReader::resyncDevice(EvdevDevice *device)
+{
+    unsigned long keyStates[(KEY_MAX / LONGBITS) + 1];
+    memset(keyStates, 0, sizeof(keyStates));
+
+    if (ioctl(device->fd, EVIOCGKEY(sizeof(keyStates)), keyStates) >= 0)
+    {
+        QHashIterator<int, int> iter(device->buttonMap);
+        while (iter.hasNext())
+        {
+            iter.next();
+            updateButton(device, iter.key(), testBit(keyStates, iter.key()));
+        }
+    }
+
+    QHashIterator<int, int> axisIter(device->axisMap);
+    while (axisIter.hasNext())
+    {
+        axisIter.next();
+        struct input_absinfo absInfo;
+        if (ioctl(device->fd, EVIOCGABS(axisIter.key()), &absInfo) >= 0)
+        {
+            updateAxis(device, axisIter.key(), absInfo.value);
+        }
+    }
+
+    QHashIterator<int, int> hatIter(device->hatMap);
+    while (hatIter.hasNext())
+    {
+        hatIter.next();
+        for (int i=0; i < 2; i++)
+        {
+            int code = ABS_HAT0X + (hatIter.key() * 2) + i;
+            struct input_absinfo absInfo;
+            if (ioctl(device->fd, EVIOCGABS(code), &absInfo) >= 0)
+            {
+                updateHat(device, code, absInfo.value);
+            }
+        }
+    }
+}
+
+void EvdevEventReader::updateButton(EvdevDevice *device, int code, bool pressed)
+{
+    int button = device->buttonMap.value(code, -1);
+    if (button >= 0 && device->buttonStates.at(button) != pressed)
+    {
+        device->buttonStates[button] = pressed;
+
+        if (!device->gameController)
+        {
+            pushJoyButton(device, button, pressed);
+        }
+        else
+        {
+            if (device->buttonToControllerButton.contains(button))
+            {
+                pushControllerButton(device, device->buttonToControllerButton.value(button), pressed);
+            }
+
+            if (device->buttonToControllerAxis.contains(button))
+            {
+                pushControllerAxis(device, device->buttonToControllerAxis.value(button),
+                                   pressed ? JoyAxis::AXISMAX : 0);
+            }
+        }
+    }
+}
+
+void EvdevEventReader::updateAxis(EvdevDevice *device, int code, int value)
+{
+    int axis = device->axisMap.value(code, -1);
+    if (axis >= 0)
+    {
+        int axisValue = correctAxisValue(device->axisCorrections.at(axis), value);
+
+        if (device->axisValues.at(axis) != axisValue)
+        {
+            device->axisValues[axis] = axisValue;
+
+            if (!device->gameController)
+            {
+                pushJoyAxis(device, axis, axisValue);
+            }
+            else
+            {
+                if (device->axisToControllerAxis.contains(axis))
+                {
+                    int controllerAxis = device->axisToControllerAxis.value(axis);
+                    int controllerValue = axisValue;
+                    if (controllerAxis == SDL_CONTROLLER_AXIS_TRIGGERLEFT ||
+                        controllerAxis == SDL_CONTROLLER_AXIS_TRIGGERRIGHT)
+                    {
+                        // Triggers use the range 0 - 32767.
+                        controllerValue = (axisValue / 2) + 16384;
+                    }
+
+                    pushControllerAxis(device, controllerAxis, controllerValue);
+                }
+            }
+        }
+    }
+}
+
+void EvdevEventReader::updateHat(EvdevDevice *device, int code, int value)
+{
+    int offset = code - ABS_HAT0X;
+    int hat = device->hatMap.value(offset / 2, -1);
+    if (hat >= 0)
+    {
+        int direction = value < 0 ? -1 : (value > 0 ? 1 : 0);
+        if ((offset % 2) == 0)
+        {
+            device->hatX[hat] = direction;
+        }
+        else
+        {
+            device->hatY[hat] = direction;
+        }
+
+        int hatValue = hatPositions[device->hatY.at(hat) + 1][device->hatX.at(hat) + 1];
+        if (device->hatValues.at(hat) != hatValue)
+        {
+            device->hatValues[hat] = hatValue;
+
+            if (!device->gameController)
+            {
+                pushJoyHat(device, hat, hatValue);
+            }
+            else
+            {
+                QListIterator<HatBind> iter(device->hatBinds);
+                while (iter.hasNext())
+                {
+                    const HatBind &hatBind = iter.next();
+                    if (hatBind.hat == hat)
+                    {
+                        pushControllerButton(device, hatBind.button, (hatValue & hatBind.mask) != 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void EvdevEventReader::pushJoyButton(EvdevDevice *device, int button, bool pressed)
+{
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = pressed ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+    event.jbutton.which = device->deviceID;
+    event.jbutton.button = button;
+    event.jbutton.state = pressed ? SDL_PRESSED : SDL_RELEASED;
+    pushEvent(event);
+}
+
+void EvdevEventReader::pushJoyAxis(EvdevDevice *device, int axis, int value)
+{
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_JOYAXISMOTION;
+    event.jaxis.which = device->deviceID;
+    event.jaxis.axis = axis;
+    event.jaxis.value = value;
+    pushEvent(event);
+}
+
+void EvdevEventReader::pushJoyHat(EvdevDevice *device, int hat, int value)
+{
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_JOYHATMOTION;
+    event.jhat.which = device->deviceID;
+    event.jhat.hat = hat;
+    event.jhat.value = value;
+    pushEvent(event);
+}
+
+void EvdevEventReader::pushControllerButton(EvdevDevice *device, int button, bool pressed)
+{
+    if (device->controllerButtonStates.at(button) != pressed)
+    {
+        device->controllerButtonStates[button] = pressed;
+
+        SDL_Event event;
+        memset(&event, 0, sizeof(event));
+        event.type = pressed ? SDL_CONTROLLERBUTTONDOWN : SDL_CONTROLLERBUTTONUP;
+        event.cbutton.which = device->deviceID;
+        event.cbutton.button = button;
+        event.cbutton.state = pressed ? SDL_PRESSED : SDL_RELEASED;
+        pushEvent(event);
+    }
+}
+
+void EvdevEventReader::pushControllerAxis(EvdevDevice *device, int axis, int value)
+{
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_CONTROLLERAXISMOTION;
+    event.caxis.which = device->deviceID;
+    event.caxis.axis = axis;
+    event.caxis.value = value;
+    pushEvent(event);
+}
+
+/**
+ * @brief Queue an event for the GUI thread. Waits while the buffer is full
+ *     rather than dropping button edges.
+ * @param Event to queue
+ */
+void EvdevEventReader::pushEvent(SDL_Event &event)
+{
+    event.common.timestamp = SDL_GetTicks();
+
+    while (!pendingEvents.enqueue(event) && stopRequested.fetchAndAddOrdered(0) == 0)
+    {
+        eventsQueued = true;
+        notifyEvents();
+        usleep(1000);
+    }
+
+    eventsQueued = true;
+}
+
+/**
+ * @brief Convert a raw evdev axis value the way the SDL Linux joystick
+ *     driver does. Values inside the flat zone of the axis are reported
+ *     as the center.
+ * @param Range and flat zone of the axis
+ * @param Raw value
+ * @return Value in the range -32768 - 32767
+ */
+int EvdevEventReader::correctAxisValue(const AxisCorrection &correction, int value)
+{
+    int result = value;
+
+    if (correction.useFlat && correction.minimum != correction.maximum)
+    {
+        qint64 temp = static_cast<qint64>(value) * 2;
+        if (temp > correction.coef[0] && temp < correction.coef[1])
+        {
+            temp = 0;
+        }
+        else
+        {
+            temp -= temp > correction.coef[0] ? correction.coef[1] : correction.coef[0];
+            temp = (temp * correction.coef[2]) >> 13;
+        }
+
+        result = static_cast<int>(qBound(Q_INT64_C(-32768), temp, Q_INT64_C(32767)));
+    }
+    else
+    {
+        result = scaleAxisValue(value, correction.minimum, correction.maximum);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Scale a raw evdev axis value to the SDL axis range.
+ * @param Raw value
+ * @param Minimum reported by the device
+ * @param Maximum reported by the device
+ * @return Value in the range -32768 - 32767
+ */
+int EvdevEventReader::scaleAxisValue(int value, int minimum, int maximum)
+{
+    int result = value;
+
+    if (maximum > minimum)
+    {
+        qint64 temp = ((static_cast<qint64>(value) - minimum) * 65535) / (static_cast<qint64>(maximum) - minimum);
+        result = qBound(-32768, static_cast<int>(temp - 32768), 32767);
+    }
+
+    return result;
+}
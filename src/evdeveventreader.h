@@ -0,0 +1,150 @@
+#ifndef EVDEVEVENTREADER_H
+#define EVDEVEVENTREADER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QQueue>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include <SDL2/SDL.h>
+
+#include "inputdevice.h"
+#include "spscringbuffer.h"
+
+struct input_event;
+
+/**
+ * @brief Read controller input straight from the Linux evdev nodes of the
+ *     devices opened through SDL. SDL is still used to enumerate devices,
+ *     for hotplug and for game controller mappings, while axis, button and
+ *     hat changes are read from /dev/input/event* with epoll on a dedicated
+ *     thread. The raw changes are translated into the same SDL joystick or
+ *     game controller events the rest of the input pipeline expects and
+ *     handed to the GUI thread through a lock-free ring buffer. Element
+ *     numbering follows the SDL Linux joystick driver. Devices whose layout
+ *     does not match what SDL reports are left to SDL. Experimental. Only
+ *     compiled with WITH_EVDEV and only used when requested with --evdev.
+ */
+class EvdevEventReader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit EvdevEventReader(QObject *parent = 0);
+    ~EvdevEventReader();
+
+    bool isOpen();
+    bool addDevice(InputDevice *device);
+    void removeDevice(SDL_JoystickID deviceID);
+    void removeAllDevices();
+    void takeEvents(QQueue<SDL_Event> *events);
+    void stop();
+
+    static const int MAXREADEVENTS;
+    static const int MAXEPOLLEVENTS;
+
+protected:
+    // Game controller button bound to a hat direction.
+    struct HatBind {
+        int hat;
+        int mask;
+        int button;
+    };
+
+    // Axis range and flat zone as used by the SDL Linux joystick driver.
+    struct AxisCorrection {
+        int minimum;
+        int maximum;
+        bool useFlat;
+        int coef[3];
+    };
+
+    struct EvdevDevice {
+        int fd;
+        QString path;
+        SDL_JoystickID deviceID;
+        bool gameController;
+        // Events were lost in the kernel buffer. Ignore events until the
+        // end of the current report and read the full state afterwards.
+        bool dropped;
+
+        // evdev code to SDL joystick element index.
+        QHash<int, int> buttonMap;
+        QHash<int, int> axisMap;
+        QHash<int, int> hatMap;
+
+        QVector<AxisCorrection> axisCorrections;
+
+        // Last state reported for each joystick element.
+        QVector<bool> buttonStates;
+        QVector<int> axisValues;
+        QVector<int> hatX;
+        QVector<int> hatY;
+        QVector<int> hatValues;
+
+        // Joystick element index to game controller element.
+        QHash<int, int> axisToControllerAxis;
+        QHash<int, int> buttonToControllerAxis;
+        QHash<int, int> buttonToControllerButton;
+        QList<HatBind> hatBinds;
+        QVector<bool> controllerButtonStates;
+    };
+
+    EvdevDevice* openDevice(SDL_Joystick *joyhandle);
+    bool configureDevice(EvdevDevice *device);
+    bool buildControllerBinds(EvdevDevice *device, InputDevice *inputDevice);
+    void closeDevice(EvdevDevice *device);
+
+    void wakeReader();
+    void notifyEvents();
+    void applyCommands();
+    void readDevice(EvdevDevice *device);
+    void handleInputEvent(EvdevDevice *device, const struct input_event &event);
+    void resyncDevice(EvdevDevice *device);
+    void updateButton(EvdevDevice *device, int code, bool pressed);
+    void updateAxis(EvdevDevice *device, int code, int value);
+    void updateHat(EvdevDevice *device, int code, int value);
+
+    void pushJoyButton(EvdevDevice *device, int button, bool pressed);
+    void pushJoyAxis(EvdevDevice *device, int axis, int value);
+    void pushJoyHat(EvdevDevice *device, int hat, int value);
+    void pushControllerButton(EvdevDevice *device, int button, bool pressed);
+    void pushControllerAxis(EvdevDevice *device, int axis, int value);
+    void pushEvent(SDL_Event &event);
+
+    static bool hasRangedBinds(const QString &mapping);
+    static int correctAxisValue(const AxisCorrection &correction, int value);
+    static int scaleAxisValue(int value, int minimum, int maximum);
+
+    int epollFd;
+    int wakeFd;
+    QAtomicInt stopRequested;
+
+    // Only used on the reader thread.
+    QHash<int, EvdevDevice*> devices;
+    bool eventsQueued;
+
+    // Device changes requested by the GUI thread. Applied by the
+    // reader thread.
+    QMutex commandMutex;
+    QList<EvdevDevice*> addedDevices;
+    QList<SDL_JoystickID> removedDevices;
+    bool removeAllRequested;
+
+    // Paths of the nodes in use. Only used on the GUI thread.
+    QHash<SDL_JoystickID, QString> devicePaths;
+
+    // Events handed from the reader thread to the GUI thread.
+    SPSCRingBuffer<SDL_Event, 1024> pendingEvents;
+    QAtomicInt notifyPending;
+
+signals:
+    void eventRaised();
+
+public slots:
+    void performWork();
+};
+
+#endif // EVDEVEVENTREADER_H
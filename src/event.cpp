@@ -12,6 +12,7 @@
 #include "event.h"
 
 #include "eventhandlerfactory.h"
+#include "inputlatencytracer.h"
 
 
 #if defined(Q_OS_UNIX)
@@ -41,11 +42,28 @@
 static MouseHelper mouseHelperObj;
 
 #ifdef Q_OS_UNIX
-    static void finalSpringEvent(Display *display, unsigned int xmovecoor, unsigned int ymovecoor)
+    /**
+     * @brief Move the cursor to the spring destination. An absolute pointer
+     *     is used when the event handler provides one. Otherwise the move
+     *     is emulated with relative movement from the current position.
+     */
+    static void finalSpringEvent(BaseEventHandler *handler, int xmovecoor, int ymovecoor,
+                                 int currentMouseX, int currentMouseY)
     {
-        Q_UNUSED(display);
-        Q_UNUSED(xmovecoor);
-        Q_UNUSED(ymovecoor);
+        if (handler->hasAbsoluteSpringSupport())
+        {
+            QRect desktopRect = QApplication::desktop()->geometry();
+            handler->sendMouseSpringEvent(qMax(0, xmovecoor - desktopRect.x()),
+                                          qMax(0, ymovecoor - desktopRect.y()),
+                                          desktopRect.width(), desktopRect.height());
+
+            mouseHelperObj.springCursorLocation[0] = xmovecoor;
+            mouseHelperObj.springCursorLocation[1] = ymovecoor;
+        }
+        else
+        {
+            handler->sendMouseEvent(xmovecoor - currentMouseX, ymovecoor - currentMouseY);
+        }
     }
 
 #elif defined(Q_OS_WIN)
@@ -67,6 +85,7 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
+        InputLatencyTracer::markStage(InputLatencyTracer::StageEventOutput);
         EventHandlerFactory::getInstance()->handler()->sendKeyboardEvent(slot, pressed);
         //if (pressed)
         //{
@@ -75,6 +94,7 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
     }
     else if (device == JoyButtonSlot::JoyMouseButton)
     {
+        InputLatencyTracer::markStage(InputLatencyTracer::StageEventOutput);
         EventHandlerFactory::getInstance()->handler()->sendMouseButtonEvent(slot, pressed);
         //if (pressed)
         //{
@@ -89,9 +109,22 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
 
 void sendevent(int code1, int code2)
 {
+    InputLatencyTracer::markStage(InputLatencyTracer::StageEventOutput);
+    invalidateSpringCursorLocation();
     EventHandlerFactory::getInstance()->handler()->sendMouseEvent(code1, code2);
 }
 
+/**
+ * @brief Forget the position last set through the absolute pointer. Has to
+ *     be called whenever the cursor is moved by relative mouse movement so
+ *     the next spring event asks the display server for the position.
+ */
+void invalidateSpringCursorLocation()
+{
+    mouseHelperObj.springCursorLocation[0] = -1;
+    mouseHelperObj.springCursorLocation[1] = -1;
+}
+
 void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::springModeInfo *relativeSpring, int* const mousePosX, int* const mousePosY)
 {
     mouseHelperObj.mouseTimer.stop();
@@ -114,19 +147,30 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
         int currentMouseX = 0;
         int currentMouseY = 0;
 
-        QDesktopWidget deskWid;
-        if (fullSpring->screen >= deskWid.screenCount())
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+        QDesktopWidget *deskWid = QApplication::desktop();
+        if (fullSpring->screen >= deskWid->screenCount())
         {
             fullSpring->screen = -1;
         }
 
-        QRect deskRect = deskWid.screenGeometry(fullSpring->screen);
+        QRect deskRect = deskWid->screenGeometry(fullSpring->screen);
 //#if defined (Q_OS_UNIX)
         width = deskRect.width();
         height = deskRect.height();
-        QPoint currentPoint = QCursor::pos();
-        currentMouseX = currentPoint.x();
-        currentMouseY = currentPoint.y();
+        if (handler->hasAbsoluteSpringSupport() && mouseHelperObj.springCursorLocation[0] != -1)
+        {
+            // The cursor was last placed by the absolute pointer. Avoid
+            // querying the display server for the cursor position.
+            currentMouseX = mouseHelperObj.springCursorLocation[0];
+            currentMouseY = mouseHelperObj.springCursorLocation[1];
+        }
+        else
+        {
+            QPoint currentPoint = QCursor::pos();
+            currentMouseX = currentPoint.x();
+            currentMouseY = currentPoint.y();
+        }
 
         //qDebug() << "Current Mouse X: " << currentMouseX;
         //qDebug() << "Current Mouse Y: " << currentMouseY;
@@ -254,8 +298,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
             if (xmovecoor == (deskRect.x() + midwidth) || ymovecoor == (deskRect.y() + midheight))
             {
 #if defined(Q_OS_UNIX)
-                EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                              ymovecoor - currentMouseY);
+                finalSpringEvent(handler, xmovecoor, ymovecoor, currentMouseX, currentMouseY);
 #elif defined(Q_OS_WIN)
                 if (fullSpring->screen <= -1)
                 {
@@ -274,8 +317,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
             {
                 mouseHelperObj.springMouseMoving = true;
 #if defined(Q_OS_UNIX)
-                EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                              ymovecoor - currentMouseY);
+                finalSpringEvent(handler, xmovecoor, ymovecoor, currentMouseX, currentMouseY);
 
 #elif defined(Q_OS_WIN)
                 if (fullSpring->screen <= -1)
@@ -293,9 +335,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
             {
                 mouseHelperObj.springMouseMoving = true;
 #if defined(Q_OS_UNIX)
-
-                EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                              ymovecoor - currentMouseY);
+                finalSpringEvent(handler, xmovecoor, ymovecoor, currentMouseX, currentMouseY);
 
 #elif defined(Q_OS_WIN)
                 if (fullSpring->screen <= -1)
@@ -323,8 +363,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
             else if (mouseHelperObj.springMouseMoving)
             {
 #if defined(Q_OS_UNIX)
-                EventHandlerFactory::getInstance()->handler()->sendMouseEvent(xmovecoor - currentMouseX,
-                                                                              ymovecoor - currentMouseY);
+                finalSpringEvent(handler, xmovecoor, ymovecoor, currentMouseX, currentMouseY);
 
 #elif defined(Q_OS_WIN)
                 if (fullSpring->screen <= -1)
@@ -366,6 +405,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
         mouseHelperObj.springMouseMoving = false;
         mouseHelperObj.pivotPoint[0] = -1;
         mouseHelperObj.pivotPoint[1] = -1;
+        invalidateSpringCursorLocation();
     }
 }
 
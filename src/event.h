@@ -11,6 +11,7 @@ enum JoyInputDevice {JoyKeyboard=0, JoyMouse};
 
 void sendevent (JoyButtonSlot *slot, bool pressed=true);
 void sendevent(int code1, int code2);
+void invalidateSpringCursorLocation();
 void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::springModeInfo *relativeSpring=0, int* const mousePosX=0, int* const mousePos=0);
 //void sendSpringEvent(double xcoor, double ycoor, int springWidth=0, int springHeight=0);
 int X11KeySymToKeycode(QString key);
@@ -14,6 +14,10 @@ static QHash<QString, QString> buildDisplayNames()
     temp.insert("xtest", "Xtest");
     temp.insert("uinput", "uinput");
 #endif
+
+#ifdef ANTIMICRO_BENCH
+    temp.insert("null", "Null");
+#endif
     return temp;
 }
 
@@ -50,6 +54,13 @@ EventHandlerFactory::EventHandlerFactory(QString handler, QObject *parent) :
     }
   #endif
 #endif
+
+#ifdef ANTIMICRO_BENCH
+    if (handler == "null")
+    {
+        eventHandler = new NullEventHandler(this);
+    }
+#endif
 }
 
 EventHandlerFactory::~EventHandlerFactory()
@@ -93,6 +104,18 @@ BaseEventHandler* EventHandlerFactory::handler()
     return eventHandler;
 }
 
+/**
+ * @brief Deliver any output buffered by the active event handler. Does
+ *     nothing if the factory has not been created yet.
+ */
+void EventHandlerFactory::flushHandlerEvents()
+{
+    if (instance && instance->eventHandler)
+    {
+        instance->eventHandler->flushEvents();
+    }
+}
+
 QString EventHandlerFactory::fallBackIdentifier()
 {
     QString temp;
@@ -124,6 +147,10 @@ QStringList EventHandlerFactory::buildEventGeneratorList()
     temp.append("xtest");
     temp.append("uinput");
 #endif
+
+#ifdef ANTIMICRO_BENCH
+    temp.append("null");
+#endif
     return temp;
 }
 
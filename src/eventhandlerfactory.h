@@ -20,6 +20,10 @@
   #endif
 #endif
 
+#ifdef ANTIMICRO_BENCH
+  #include "eventhandlers/nulleventhandler.h"
+#endif
+
 #ifdef Q_OS_WIN
   #define ADD_SENDINPUT 1
   #ifdef WITH_VMULTI
@@ -61,6 +65,7 @@ public:
     static QString fallBackIdentifier();
     static QStringList buildEventGeneratorList();
     static QString handlerDisplayName(QString handler);
+    static void flushHandlerEvents();
 
 protected:
     explicit EventHandlerFactory(QString handler, QObject *parent = 0);
@@ -44,3 +44,45 @@ void BaseEventHandler::sendMouseSpringEvent(unsigned int xDis, unsigned int yDis
     Q_UNUSED(width);
     Q_UNUSED(height);
 }
+
+/**
+ * @brief Check if sendMouseSpringEvent places the cursor directly.
+ *     Spring mode will otherwise emulate absolute positioning
+ *     using relative mouse movement.
+ * @return Whether absolute spring events are supported
+ */
+bool BaseEventHandler::hasAbsoluteSpringSupport()
+{
+    return false;
+}
+
+/**
+ * @brief Do nothing by default. Handlers that can be used by the mouse
+ *     motion thread should write relative movement immediately. Called
+ *     from a thread other than the GUI thread.
+ * @param Displacement of X coordinate
+ * @param Displacement of Y coordinate
+ */
+void BaseEventHandler::sendThreadedMouseEvent(int xDis, int yDis)
+{
+    Q_UNUSED(xDis);
+    Q_UNUSED(yDis);
+}
+
+/**
+ * @brief Check if sendThreadedMouseEvent can be called from the mouse
+ *     motion thread.
+ * @return Whether threaded mouse events are supported
+ */
+bool BaseEventHandler::hasThreadedMouseSupport()
+{
+    return false;
+}
+
+/**
+ * @brief Do nothing by default. Handlers that buffer output events should
+ *     deliver any pending events when this is called.
+ */
+void BaseEventHandler::flushEvents()
+{
+}
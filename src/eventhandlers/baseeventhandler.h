@@ -25,6 +25,9 @@ public:
     virtual void sendMouseAbsEvent(int xDis, int yDis);
     virtual void sendMouseSpringEvent(unsigned int xDis, unsigned int yDis,
                                       unsigned int width, unsigned int height);
+    virtual bool hasAbsoluteSpringSupport();
+    virtual void sendThreadedMouseEvent(int xDis, int yDis);
+    virtual bool hasThreadedMouseSupport();
 
 protected:
     QString lastErrorString;
@@ -32,6 +35,7 @@ protected:
 signals:
 
 public slots:
+    virtual void flushEvents();
 
 };
 
@@ -0,0 +1,78 @@
+#include "nulleventhandler.h"
+
+/**
+ * @brief Event handler that discards all events. Only used by the
+ *     benchmark harness so that output can be counted without
+ *     affecting the running desktop session.
+ */
+NullEventHandler::NullEventHandler(QObject *parent) :
+    BaseEventHandler(parent)
+{
+    resetCounts();
+}
+
+bool NullEventHandler::init()
+{
+    return true;
+}
+
+bool NullEventHandler::cleanup()
+{
+    return true;
+}
+
+void NullEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
+{
+    Q_UNUSED(slot);
+    Q_UNUSED(pressed);
+
+    keyboardEvents++;
+}
+
+void NullEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
+{
+    Q_UNUSED(slot);
+    Q_UNUSED(pressed);
+
+    mouseButtonEvents++;
+}
+
+void NullEventHandler::sendMouseEvent(int xDis, int yDis)
+{
+    Q_UNUSED(xDis);
+    Q_UNUSED(yDis);
+
+    mouseEvents++;
+}
+
+QString NullEventHandler::getName()
+{
+    return QString("Null");
+}
+
+QString NullEventHandler::getIdentifier()
+{
+    return QString("null");
+}
+
+unsigned long NullEventHandler::getKeyboardEventCount()
+{
+    return keyboardEvents;
+}
+
+unsigned long NullEventHandler::getMouseButtonEventCount()
+{
+    return mouseButtonEvents;
+}
+
+unsigned long NullEventHandler::getMouseEventCount()
+{
+    return mouseEvents;
+}
+
+void NullEventHandler::resetCounts()
+{
+    keyboardEvents = 0;
+    mouseButtonEvents = 0;
+    mouseEvents = 0;
+}
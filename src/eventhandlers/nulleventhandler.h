@@ -0,0 +1,38 @@
+#ifndef NULLEVENTHANDLER_H
+#define NULLEVENTHANDLER_H
+
+#include "baseeventhandler.h"
+
+#include <joybuttonslot.h>
+
+class NullEventHandler : public BaseEventHandler
+{
+    Q_OBJECT
+public:
+    explicit NullEventHandler(QObject *parent = 0);
+
+    virtual bool init();
+    virtual bool cleanup();
+    virtual void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed);
+    virtual void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed);
+    virtual void sendMouseEvent(int xDis, int yDis);
+    virtual QString getName();
+    virtual QString getIdentifier();
+
+    unsigned long getKeyboardEventCount();
+    unsigned long getMouseButtonEventCount();
+    unsigned long getMouseEventCount();
+    void resetCounts();
+
+protected:
+    unsigned long keyboardEvents;
+    unsigned long mouseButtonEvents;
+    unsigned long mouseEvents;
+
+signals:
+
+public slots:
+
+};
+
+#endif // NULLEVENTHANDLER_H
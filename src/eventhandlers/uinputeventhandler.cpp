@@ -1,5 +1,7 @@
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <string.h>
 #include <linux/input.h>
 #include <linux/uinput.h>
 
@@ -30,12 +32,24 @@
 
 static const QString mouseDeviceName("antimicro Mouse Emulation");
 static const QString keyboardDeviceName("antimicro Keyboard Emulation");
+static const QString springMouseDeviceName("antimicro Abs Mouse Emulation");
+
+const int UInputEventHandler::SPRINGABSMAX = 65535;
 
 UInputEventHandler::UInputEventHandler(QObject *parent) :
     BaseEventHandler(parent)
 {
     keyboardFileHandler = 0;
     mouseFileHandler = 0;
+    springMouseFileHandler = 0;
+    springAbsoluteEnabled = false;
+    flushScheduled = false;
+    writeErrorLogged = false;
+
+    // Reserved capacity is kept when the buffers are emptied.
+    keyboardEventBuffer.reserve(32);
+    mouseEventBuffer.reserve(32);
+    springMouseEventBuffer.reserve(8);
 }
 
 UInputEventHandler::~UInputEventHandler()
@@ -81,6 +95,22 @@ bool UInputEventHandler::init()
         }
     }
 
+    if (result && springAbsoluteEnabled)
+    {
+        // Absolute pointer used by spring mode. Failing to create it is
+        // not fatal since spring mode can fall back to relative movement.
+        springMouseFileHandler = openUInputHandle();
+        if (springMouseFileHandler > 0)
+        {
+            setSpringMouseEvents(springMouseFileHandler);
+            createUInputSpringMouseDevice(springMouseFileHandler);
+        }
+        else
+        {
+            springMouseFileHandler = 0;
+        }
+    }
+
 #ifdef WITH_X11
     if (result)
     {
@@ -212,6 +242,9 @@ void UInputEventHandler::x11ResetMouseAccelerationChange()
 
 bool UInputEventHandler::cleanup()
 {
+    // Make sure pending releases reach the virtual devices.
+    flushEvents();
+
     if (keyboardFileHandler > 0)
     {
         closeUInputDevice(keyboardFileHandler);
@@ -224,6 +257,12 @@ bool UInputEventHandler::cleanup()
         mouseFileHandler = 0;
     }
 
+    if (springMouseFileHandler > 0)
+    {
+        closeUInputDevice(springMouseFileHandler);
+        springMouseFileHandler = 0;
+    }
+
     return true;
 }
 
@@ -311,8 +350,105 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 
 void UInputEventHandler::sendMouseEvent(int xDis, int yDis)
 {
-    write_uinput_event(mouseFileHandler, EV_REL, REL_X, xDis, false);
-    write_uinput_event(mouseFileHandler, EV_REL, REL_Y, yDis);
+    if (xDis != 0)
+    {
+        write_uinput_event(mouseFileHandler, EV_REL, REL_X, xDis);
+    }
+
+    if (yDis != 0)
+    {
+        write_uinput_event(mouseFileHandler, EV_REL, REL_Y, yDis);
+    }
+}
+
+/**
+ * @brief Move the cursor to an absolute position using the absolute
+ *     pointer device. Coordinates are scaled to the range of the device
+ *     which the display server maps onto the full desktop.
+ * @param X coordinate relative to the desktop origin
+ * @param Y coordinate relative to the desktop origin
+ * @param Desktop width
+ * @param Desktop height
+ */
+void UInputEventHandler::sendMouseSpringEvent(unsigned int xDis, unsigned int yDis,
+                                              unsigned int width, unsigned int height)
+{
+    if (springMouseFileHandler > 0 && width > 1 && height > 1)
+    {
+        int fx = (qMin(xDis, width - 1) * SPRINGABSMAX) / (width - 1);
+        int fy = (qMin(yDis, height - 1) * SPRINGABSMAX) / (height - 1);
+
+        write_uinput_event(springMouseFileHandler, EV_ABS, ABS_X, fx);
+        write_uinput_event(springMouseFileHandler, EV_ABS, ABS_Y, fy);
+    }
+}
+
+bool UInputEventHandler::hasAbsoluteSpringSupport()
+{
+    return springMouseFileHandler > 0;
+}
+
+/**
+ * @brief Write relative mouse movement straight to the mouse device.
+ *     Used by the mouse motion thread. The events bypass the queued
+ *     buffers so nothing shared with the GUI thread is touched. The
+ *     frame is written with a single call so it cannot be split by
+ *     frames flushed from the GUI thread.
+ * @param Displacement of X coordinate
+ * @param Displacement of Y coordinate
+ */
+void UInputEventHandler::sendThreadedMouseEvent(int xDis, int yDis)
+{
+    if (mouseFileHandler > 0 && (xDis != 0 || yDis != 0))
+    {
+        struct input_event frame[3];
+        memset(frame, 0, sizeof(frame));
+        int count = 0;
+
+        if (xDis != 0)
+        {
+            frame[count].type = EV_REL;
+            frame[count].code = REL_X;
+            frame[count].value = xDis;
+            count++;
+        }
+
+        if (yDis != 0)
+        {
+            frame[count].type = EV_REL;
+            frame[count].code = REL_Y;
+            frame[count].value = yDis;
+            count++;
+        }
+
+        frame[count].type = EV_SYN;
+        frame[count].code = SYN_REPORT;
+        frame[count].value = 0;
+        count++;
+
+        int result = 0;
+        result = write(mouseFileHandler, frame, sizeof(struct input_event) * count);
+    }
+}
+
+bool UInputEventHandler::hasThreadedMouseSupport()
+{
+    return mouseFileHandler > 0;
+}
+
+/**
+ * @brief Set whether an absolute pointer device should be created for
+ *     spring mode. Only takes effect when called before init.
+ * @param Absolute pointer status
+ */
+void UInputEventHandler::setSpringAbsoluteStatus(bool enabled)
+{
+    springAbsoluteEnabled = enabled;
+}
+
+bool UInputEventHandler::isSpringAbsoluteEnabled()
+{
+    return springAbsoluteEnabled;
 }
 
 int UInputEventHandler::openUInputHandle()
@@ -396,6 +532,21 @@ void UInputEventHandler::setMouseEvents(int filehandle)
     result = ioctl(filehandle, UI_SET_KEYBIT, BTN_EXTRA);
 }
 
+void UInputEventHandler::setSpringMouseEvents(int filehandle)
+{
+    int result = 0;
+    result = ioctl(filehandle, UI_SET_EVBIT, EV_KEY);
+    result = ioctl(filehandle, UI_SET_EVBIT, EV_SYN);
+    result = ioctl(filehandle, UI_SET_EVBIT, EV_ABS);
+
+    result = ioctl(filehandle, UI_SET_ABSBIT, ABS_X);
+    result = ioctl(filehandle, UI_SET_ABSBIT, ABS_Y);
+
+    // A button is needed for the device to be classified as a pointer
+    // instead of a touchscreen or joystick.
+    result = ioctl(filehandle, UI_SET_KEYBIT, BTN_LEFT);
+}
+
 void UInputEventHandler::populateKeyCodes(int filehandle)
 {
     int result = 0;
@@ -439,6 +590,28 @@ void UInputEventHandler::createUInputMouseDevice(int filehandle)
     result = ioctl(filehandle, UI_DEV_CREATE);
 }
 
+void UInputEventHandler::createUInputSpringMouseDevice(int filehandle)
+{
+    struct uinput_user_dev uidev;
+
+    memset(&uidev, 0, sizeof(uidev));
+    QByteArray temp = springMouseDeviceName.toUtf8();
+    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
+    uidev.id.bustype = BUS_USB;
+    uidev.id.vendor  = 0x0;
+    uidev.id.product = 0x0;
+    uidev.id.version = 1;
+
+    uidev.absmin[ABS_X] = 0;
+    uidev.absmax[ABS_X] = SPRINGABSMAX;
+    uidev.absmin[ABS_Y] = 0;
+    uidev.absmax[ABS_Y] = SPRINGABSMAX;
+
+    int result = 0;
+    result = write(filehandle, &uidev, sizeof(uidev));
+    result = ioctl(filehandle, UI_DEV_CREATE);
+}
+
 void UInputEventHandler::closeUInputDevice(int filehandle)
 {
     int result = 0;
@@ -447,32 +620,125 @@ void UInputEventHandler::closeUInputDevice(int filehandle)
 }
 
 
-void UInputEventHandler::write_uinput_event(int filehandle, unsigned int type, unsigned int code, int value, bool syn)
+/**
+ * @brief Queue an event for a virtual device. Events are buffered until
+ *     flushEvents is called so that all changes made during an input
+ *     frame reach the device in one write terminated by a single
+ *     EV_SYN. A key that changes again within the frame ends the frame
+ *     early. A press and release in the same report would otherwise be
+ *     seen as no change. A flush is also scheduled on the event loop for
+ *     events generated outside of a frame, such as those triggered by
+ *     timers.
+ * @param File handle of the virtual device
+ * @param Event type
+ * @param Event code
+ * @param Event value
+ */
+void UInputEventHandler::write_uinput_event(int filehandle, unsigned int type, unsigned int code, int value)
 {
+    // The input core stamps events when they are injected so the time
+    // field is left empty.
     struct input_event ev;
-    struct input_event ev2;
-
     memset(&ev, 0, sizeof(struct input_event));
-    gettimeofday(&ev.time, 0);
     ev.type = type;
     ev.code = code;
     ev.value = value;
 
-    int result = 0;
-    result = write(filehandle, &ev, sizeof(struct input_event));
+    QVector<struct input_event> *buffer = &mouseEventBuffer;
+    if (filehandle == keyboardFileHandler)
+    {
+        buffer = &keyboardEventBuffer;
+    }
+    else if (filehandle == springMouseFileHandler)
+    {
+        buffer = &springMouseEventBuffer;
+    }
+
+    if (type == EV_KEY)
+    {
+        bool keyQueued = false;
+        for (int i=0; i < buffer->size() && !keyQueued; i++)
+        {
+            const struct input_event &queued = buffer->at(i);
+            keyQueued = queued.type == EV_KEY && queued.code == code;
+        }
+
+        if (keyQueued)
+        {
+            flushEventBuffer(filehandle, *buffer);
+        }
+    }
+
+    buffer->append(ev);
+
+    if (!flushScheduled)
+    {
+        flushScheduled = true;
+        QTimer::singleShot(0, this, SLOT(flushEvents()));
+    }
+}
 
-    if (syn)
+void UInputEventHandler::flushEventBuffer(int filehandle, QVector<struct input_event> &buffer)
+{
+    if (!buffer.isEmpty())
     {
-        memset(&ev2, 0, sizeof(struct input_event));
-        gettimeofday(&ev2.time, 0);
-        ev2.type = EV_SYN;
-        ev2.code = SYN_REPORT;
-        ev2.value = 0;
+        struct input_event ev;
+        memset(&ev, 0, sizeof(struct input_event));
+        ev.type = EV_SYN;
+        ev.code = SYN_REPORT;
+        ev.value = 0;
+        buffer.append(ev);
+
+        if (filehandle > 0)
+        {
+            const char *data = reinterpret_cast<const char*>(buffer.constData());
+            size_t remaining = sizeof(struct input_event) * buffer.size();
+            bool writing = true;
+
+            while (writing && remaining > 0)
+            {
+                ssize_t result = write(filehandle, data, remaining);
+                if (result > 0)
+                {
+                    data += result;
+                    remaining -= result;
+                }
+                else if (result == 0 || errno != EINTR)
+                {
+                    writing = false;
+                }
+            }
 
-        result = write(filehandle, &ev2, sizeof(struct input_event));
+            // Only report the first failure until writing works again.
+            if (remaining > 0 && !writeErrorLogged)
+            {
+                Logger::LogError(tr("Could not write events to uinput device: %1")
+                                 .arg(QString::fromLocal8Bit(strerror(errno))));
+                writeErrorLogged = true;
+            }
+            else if (remaining == 0)
+            {
+                writeErrorLogged = false;
+            }
+        }
+
+        buffer.resize(0);
     }
 }
 
+/**
+ * @brief Write all queued events to the virtual devices. Each device
+ *     receives one write followed by a single EV_SYN.
+ */
+void UInputEventHandler::flushEvents()
+{
+    flushScheduled = false;
+
+    flushEventBuffer(keyboardFileHandler, keyboardEventBuffer);
+    flushEventBuffer(mouseFileHandler, mouseEventBuffer);
+    flushEventBuffer(springMouseFileHandler, springMouseEventBuffer);
+}
+
 QString UInputEventHandler::getName()
 {
     return QString("uinput");
@@ -495,4 +761,9 @@ void UInputEventHandler::printPostMessages()
         Logger::LogInfo(tr("Using uinput device file %1").arg(uinputDeviceLocation));
         //out << tr("Using uinput device file %1").arg(uinputDeviceLocation) << endl;
     }
+
+    if (springMouseFileHandler > 0)
+    {
+        Logger::LogInfo(tr("Using absolute pointer device for spring mode"));
+    }
 }
@@ -1,6 +1,10 @@
 #ifndef UINPUTEVENTHANDLER_H
 #define UINPUTEVENTHANDLER_H
 
+#include <linux/input.h>
+
+#include <QVector>
+
 #include "baseeventhandler.h"
 
 #include <springmousemoveinfo.h>
@@ -18,28 +22,49 @@ public:
     virtual void sendKeyboardEvent(JoyButtonSlot *slot, bool pressed);
     virtual void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed);
     virtual void sendMouseEvent(int xDis, int yDis);
+    virtual void sendMouseSpringEvent(unsigned int xDis, unsigned int yDis,
+                                      unsigned int width, unsigned int height);
+    virtual bool hasAbsoluteSpringSupport();
+    virtual void sendThreadedMouseEvent(int xDis, int yDis);
+    virtual bool hasThreadedMouseSupport();
     virtual QString getName();
     virtual QString getIdentifier();
     virtual void printPostMessages();
 
+    void setSpringAbsoluteStatus(bool enabled);
+    bool isSpringAbsoluteEnabled();
+
+    static const int SPRINGABSMAX;
+
 protected:
     int openUInputHandle();
     void setKeyboardEvents(int filehandle);
     void setMouseEvents(int filehandle);
+    void setSpringMouseEvents(int filehandle);
     void populateKeyCodes(int filehandle);
     void createUInputKeyboardDevice(int filehandle);
     void createUInputMouseDevice(int filehandle);
+    void createUInputSpringMouseDevice(int filehandle);
     void closeUInputDevice(int filehandle);
     void write_uinput_event(int filehandle, unsigned int type,
-                            unsigned int code, int value, bool syn=true);
+                            unsigned int code, int value);
+    void flushEventBuffer(int filehandle, QVector<struct input_event> &buffer);
 
     int keyboardFileHandler;
     int mouseFileHandler;
+    int springMouseFileHandler;
+    bool springAbsoluteEnabled;
     QString uinputDeviceLocation;
+    QVector<struct input_event> keyboardEventBuffer;
+    QVector<struct input_event> mouseEventBuffer;
+    QVector<struct input_event> springMouseEventBuffer;
+    bool flushScheduled;
+    bool writeErrorLogged;
 
 signals:
 
 public slots:
+    virtual void flushEvents();
 
 private slots:
 #ifdef WITH_X11
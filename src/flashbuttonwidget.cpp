@@ -23,22 +23,30 @@ FlashButtonWidget::FlashButtonWidget(bool displayNames, QWidget *parent) :
 
 void FlashButtonWidget::flash()
 {
-    isflashing = true;
+    flashState.flash(this);
+}
 
-    this->style()->unpolish(this);
-    this->style()->polish(this);
+void FlashButtonWidget::unflash()
+{
+    flashState.unflash(this);
+}
 
-    emit flashed(isflashing);
+void FlashButtonWidget::applyFrameUpdate()
+{
+    applyFlashState(flashState.takeFrameState(this));
 }
 
-void FlashButtonWidget::unflash()
+void FlashButtonWidget::applyFlashState(bool flashing)
 {
-    isflashing = false;
+    if (isflashing != flashing)
+    {
+        isflashing = flashing;
 
-    this->style()->unpolish(this);
-    this->style()->polish(this);
+        this->style()->unpolish(this);
+        this->style()->polish(this);
 
-    emit flashed(isflashing);
+        emit flashed(isflashing);
+    }
 }
 
 void FlashButtonWidget::refreshLabel()
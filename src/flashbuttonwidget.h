@@ -4,6 +4,8 @@
 #include <QPushButton>
 #include <QPaintEvent>
 
+#include "uiupdatebus.h"
+
 class FlashButtonWidget : public QPushButton
 {
     Q_OBJECT
@@ -21,8 +23,11 @@ protected:
     virtual void paintEvent(QPaintEvent *event);
     virtual QString generateLabel() = 0;
     virtual void retranslateUi();
+    void applyFlashState(bool flashing);
 
     bool isflashing;
+    // Flash state requested since the last frame update.
+    UiFlashState flashState;
     bool displayNames;
     bool leftAlignText;
 
@@ -38,6 +43,7 @@ public slots:
 protected slots:
     void flash();
     void unflash();
+    void applyFrameUpdate();
 };
 
 #endif // FLASHBUTTONWIDGET_H
@@ -15,12 +15,14 @@ GameController::GameController(SDL_GameController *controller, int deviceIndex,
     SDL_Joystick *joyhandle = SDL_GameControllerGetJoystick(controller);
     joystickID = SDL_JoystickInstanceID(joyhandle);
 
-    for (int i=0; i < NUMBER_JOYSETS; i++)
-    {
-        GameControllerSet *controllerset = new GameControllerSet(this, i, this);
-        joystick_sets.insert(i, controllerset);
-        enableSetConnections(controllerset);
-    }
+    // Only the first set is created up front. The other sets are
+    // created when they are first used.
+    getSetJoystick(0);
+}
+
+SetJoystick* GameController::createSetJoystick(int index)
+{
+    return new GameControllerSet(this, index, this);
 }
 
 QString GameController::getName()
@@ -145,9 +147,9 @@ void GameController::readJoystickConfig(QXmlStreamReader *xml)
                     {
                         int index = xml->attributes().value("index").toString().toInt();
                         index = index - 1;
-                        if (index >= 0 && index < joystick_sets.size())
+                        if (index >= 0 && index < NUMBER_JOYSETS)
                         {
-                            GameControllerSet *currentSet = static_cast<GameControllerSet*>(joystick_sets.value(index));
+                            GameControllerSet *currentSet = static_cast<GameControllerSet*>(getSetJoystick(index));
                             currentSet->readJoystickConfig(xml, buttons, axes, hatButtons);
                         }
                     }
@@ -453,9 +455,9 @@ void GameController::readConfig(QXmlStreamReader *xml)
                     {
                         int index = xml->attributes().value("index").toString().toInt();
                         index = index - 1;
-                        if (index >= 0 && index < joystick_sets.size())
+                        if (index >= 0 && index < NUMBER_JOYSETS)
                         {
-                            joystick_sets.value(index)->readConfig(xml);
+                            getSetJoystick(index)->readConfig(xml);
                         }
                     }
                     else
@@ -723,9 +725,13 @@ void GameController::writeConfig(QXmlStreamWriter *xml)
     }
 
     xml->writeStartElement("sets");
-    for (int i=0; i < joystick_sets.size(); i++)
+    for (int i=0; i < NUMBER_JOYSETS; i++)
     {
-        joystick_sets.value(i)->writeConfig(xml);
+        SetJoystick *currentSet = findSetJoystick(i);
+        if (currentSet)
+        {
+            currentSet->writeConfig(xml);
+        }
     }
     xml->writeEndElement();
 
@@ -788,6 +794,21 @@ SDL_GameControllerButtonBind GameController::getBindForButton(int index)
     return bind;
 }
 
+QString GameController::getMappingString()
+{
+    QString temp;
+
+    char *mapping = SDL_GameControllerMapping(controller);
+    if (mapping)
+    {
+        temp = QString::fromUtf8(mapping);
+        SDL_free(mapping);
+        mapping = 0;
+    }
+
+    return temp;
+}
+
 void GameController::buttonClickEvent(int buttonindex)
 {
     SDL_GameControllerButtonBind bind = getBindForButton((SDL_GameControllerButton)buttonindex);
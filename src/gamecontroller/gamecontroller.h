@@ -34,6 +34,7 @@ public:
 
     SDL_GameControllerButtonBind getBindForAxis(int index);
     SDL_GameControllerButtonBind getBindForButton(int index);
+    QString getMappingString();
 
     virtual void readConfig(QXmlStreamReader *xml);
     virtual void writeConfig(QXmlStreamWriter *xml);
@@ -41,6 +42,7 @@ public:
     static const QString xmlName;
 
 protected:
+    virtual SetJoystick* createSetJoystick(int index);
     void readJoystickConfig(QXmlStreamReader *xml);
 
     SDL_GameController *controller;
@@ -6,6 +6,9 @@
 
 #include "inputdaemon.h"
 #include "logger.h"
+#include "inputlatencytracer.h"
+#include "eventhandlerfactory.h"
+#include "joycontrolstick.h"
 
 const int InputDaemon::GAMECONTROLLERTRIGGERRELEASE = 16384;
 
@@ -16,8 +19,16 @@ InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks, AntiMicr
     this->stopped = false;
     this->graphical = graphical;
     this->settings = settings;
+    this->inputRecorder = 0;
+
+#ifdef WITH_EVDEV
+    evdevWorker = 0;
+    evdevThread = 0;
+    sdlInputEventsIgnored = false;
+#endif
 
     eventWorker = new SDLEventReader(joysticks, settings);
+    eventWorker->setEventDrainStatus(graphical && settings->runtimeValue("Input/DrainOnThread", false).toBool());
     thread = new QThread();
     eventWorker->moveToThread(thread);
 
@@ -30,7 +41,14 @@ InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice*> *joysticks, AntiMicr
         //pollResetTimer.setSingleShot(true);
         pollResetTimer.setInterval(11);
         connect(&pollResetTimer, SIGNAL(timeout()), this, SLOT(resetActiveButtonMouseDistances()));
-        thread->start();
+        startWorkerThread();
+
+#ifdef WITH_EVDEV
+        if (settings->runtimeValue("Input/Evdev", false).toBool())
+        {
+            startEvdevWorker();
+        }
+#endif
     }
 
     refreshJoysticks();
@@ -58,11 +76,34 @@ void InputDaemon::startWorker()
     {
         connect(thread, SIGNAL(started()), eventWorker, SLOT(performWork()));
         connect(eventWorker, SIGNAL(eventRaised()), this, SLOT(run()));
-        thread->start();
+        startWorkerThread();
         pollResetTimer.start();
     }
 }
 
+/**
+ * @brief Set the recorder that will receive every raw controller event
+ *     accepted in the first input pass. Ownership is not transferred.
+ * @param Recorder instance. NULL disables recording.
+ */
+void InputDaemon::setInputRecorder(InputTraceRecorder *recorder)
+{
+    inputRecorder = recorder;
+}
+
+void InputDaemon::startWorkerThread()
+{
+    if (eventWorker->isEventDrainEnabled())
+    {
+        // The reader thread is now on the latency critical path.
+        thread->start(QThread::TimeCriticalPriority);
+    }
+    else
+    {
+        thread->start();
+    }
+}
+
 void InputDaemon::run ()
 {
     //SDL_Event event;
@@ -86,6 +127,9 @@ void InputDaemon::run ()
         secondInputPass(&sdlEventQueue);
 
         clearBitArrayStatusInstances();
+
+        // Deliver all output generated by this poll as one frame.
+        EventHandlerFactory::flushHandlerEvents();
     }
 
     //qDebug() << QTime::currentTime() << ": " << "END";
@@ -100,8 +144,25 @@ void InputDaemon::run ()
     }
     else
     {
-        QTimer::singleShot(0, eventWorker, SLOT(performWork()));
-        pollResetTimer.start();
+        bool evdevRun = false;
+#ifdef WITH_EVDEV
+        // The SDL reader is still waiting when evdev input
+        // triggered this run.
+        evdevRun = evdevWorker && sender() == evdevWorker;
+#endif
+
+        if (!eventWorker->isEventDrainEnabled() && !evdevRun)
+        {
+            QTimer::singleShot(0, eventWorker, SLOT(performWork()));
+        }
+
+        // The reset is only needed while mouse slots are active. Leave
+        // the timer stopped otherwise so idle controllers cause no
+        // periodic wakeups.
+        if (!JoyButton::getPendingMouseButtons()->isEmpty())
+        {
+            pollResetTimer.start();
+        }
     }
 }
 
@@ -125,6 +186,15 @@ void InputDaemon::refreshJoysticks()
     trackcontrollers.clear();
 #endif
 
+#ifdef WITH_EVDEV
+    if (evdevWorker)
+    {
+        evdevWorker->removeAllDevices();
+        evdevDevices.clear();
+        updateSDLInputEventState();
+    }
+#endif
+
 #ifdef USE_SDL_2
     settings->beginGroup("Mappings");
 #endif
@@ -146,11 +216,19 @@ void InputDaemon::refreshJoysticks()
         if (SDL_IsGameController(i) && !disableGameController)
         {
             SDL_GameController *controller = SDL_GameControllerOpen(i);
+
+            // The controller holds its own reference to the joystick.
+            SDL_JoystickClose(joystick);
+            joystick = 0;
+
             GameController *damncontroller = new GameController(controller, i, settings, this);
             SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
             SDL_JoystickID joystickID = SDL_JoystickInstanceID(sdlStick);
             joysticks->insert(joystickID, damncontroller);
             trackcontrollers.insert(joystickID, damncontroller);
+#ifdef WITH_EVDEV
+            attachEvdevDevice(damncontroller);
+#endif
         }
         else
         {
@@ -158,6 +236,9 @@ void InputDaemon::refreshJoysticks()
             SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
             joysticks->insert(joystickID, curJoystick);
             trackjoysticks.insert(joystickID, curJoystick);
+#ifdef WITH_EVDEV
+            attachEvdevDevice(curJoystick);
+#endif
         }
 #else
         SDL_Joystick *joystick = SDL_JoystickOpen(i);
@@ -178,6 +259,12 @@ void InputDaemon::stop()
     stopped = true;
 }
 
+/**
+ * @brief Restart SDL and reopen every device. Only used when the user asks
+ *     for a refresh so that changed mappings and disabled game controller
+ *     support take effect. Hotplug events only add or remove the affected
+ *     device.
+ */
 void InputDaemon::refresh()
 {
     stop();
@@ -213,6 +300,10 @@ void InputDaemon::quit()
     stopped = true;
     disconnect(eventWorker, SIGNAL(eventRaised()), this, 0);
 
+#ifdef WITH_EVDEV
+    stopEvdevWorker();
+#endif
+
     // Wait for SDL to finish. Let worker destructor close SDL.
     // Let InputDaemon destructor close thread instance.
     if (graphical)
@@ -247,8 +338,7 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
 
     for (int i=0; i < SDL_NumJoysticks() && !found; i++)
     {
-        SDL_Joystick *joystick = SDL_JoystickOpen(i);
-        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
+        SDL_JoystickID joystickID = getDeviceInstanceID(i);
         if (device->getSDLJoystickID() == joystickID)
         {
             found = true;
@@ -272,6 +362,9 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     device->closeSDLDevice();
                     trackjoysticks.remove(joystickID);
                     joysticks->remove(joystickID);
+#ifdef WITH_EVDEV
+                    detachEvdevDevice(joystickID);
+#endif
 
                     SDL_GameController *controller = SDL_GameControllerOpen(i);
                     GameController *damncontroller = new GameController(controller, i, settings, this);
@@ -279,6 +372,9 @@ void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
                     joystickID = SDL_JoystickInstanceID(sdlStick);
                     joysticks->insert(joystickID, damncontroller);
                     trackcontrollers.insert(joystickID, damncontroller);
+#ifdef WITH_EVDEV
+                    attachEvdevDevice(damncontroller);
+#endif
                     emit deviceUpdated(i, damncontroller);
                 }
             }
@@ -295,6 +391,9 @@ void InputDaemon::removeDevice(InputDevice *device)
         joysticks->remove(deviceID);
         trackjoysticks.remove(deviceID);
         trackcontrollers.remove(deviceID);
+#ifdef WITH_EVDEV
+        detachEvdevDevice(deviceID);
+#endif
 
         refreshIndexes();
 
@@ -307,8 +406,7 @@ void InputDaemon::refreshIndexes()
 {
     for (int i = 0; i < SDL_NumJoysticks(); i++)
     {
-        SDL_Joystick *joystick = SDL_JoystickOpen(i);
-        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
+        SDL_JoystickID joystickID = getDeviceInstanceID(i);
         InputDevice *tempdevice = joysticks->value(joystickID);
         if (tempdevice)
         {
@@ -319,13 +417,56 @@ void InputDaemon::refreshIndexes()
 
 void InputDaemon::addInputDevice(int index)
 {
+    InputDevice *device = openInputDevice(index);
+    if (device)
+    {
+        emit deviceAdded(device);
+    }
+}
+
+/**
+ * @brief Get the instance ID of the device at an SDL device index without
+ *     keeping another reference to the device open.
+ * @param SDL device index
+ * @return Instance ID of the device. -1 if the index is not valid.
+ */
+SDL_JoystickID InputDaemon::getDeviceInstanceID(int index)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+    return SDL_JoystickGetDeviceInstanceID(index);
+#else
+    SDL_JoystickID joystickID = -1;
+
+    // Opening a device that is already open only adds a reference
+    // to it. Release it right away.
     SDL_Joystick *joystick = SDL_JoystickOpen(index);
     if (joystick)
     {
-        SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(joystick);
+        joystickID = SDL_JoystickInstanceID(joystick);
+        SDL_JoystickClose(joystick);
+    }
+
+    return joystickID;
+#endif
+}
 
-        if (!joysticks->contains(tempJoystickID))
+/**
+ * @brief Open the device at an SDL device index and start tracking it.
+ *     Devices that are already tracked are left untouched.
+ * @param SDL device index
+ * @return Newly opened device. 0 if no device was opened.
+ */
+InputDevice* InputDaemon::openInputDevice(int index)
+{
+    InputDevice *device = 0;
+
+    if (!joysticks->contains(getDeviceInstanceID(index)))
+    {
+        SDL_Joystick *joystick = SDL_JoystickOpen(index);
+        if (joystick)
         {
+            SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(joystick);
+
             settings->beginGroup("Mappings");
 
             QString temp;
@@ -339,24 +480,20 @@ void InputDaemon::addInputDevice(int index)
             if (SDL_IsGameController(index) && !disableGameController)
             {
                 SDL_GameController *controller = SDL_GameControllerOpen(index);
-                if (controller)
-                {
-                    SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
-                    SDL_JoystickID tempJoystickID = SDL_JoystickInstanceID(sdlStick);
-                    if (!joysticks->contains(tempJoystickID))
-                    {
-                        GameController *damncontroller = new GameController(controller, index, settings, this);
-                        joysticks->insert(tempJoystickID, damncontroller);
-                        trackcontrollers.insert(tempJoystickID, damncontroller);
 
-                        settings->endGroup();
+                // The controller holds its own reference to the joystick.
+                SDL_JoystickClose(joystick);
+                joystick = 0;
 
-                        emit deviceAdded(damncontroller);
-                    }
-                }
-                else
+                if (controller)
                 {
-                    settings->endGroup();
+                    GameController *damncontroller = new GameController(controller, index, settings, this);
+                    joysticks->insert(tempJoystickID, damncontroller);
+                    trackcontrollers.insert(tempJoystickID, damncontroller);
+#ifdef WITH_EVDEV
+                    attachEvdevDevice(damncontroller);
+#endif
+                    device = damncontroller;
                 }
             }
             else
@@ -364,13 +501,17 @@ void InputDaemon::addInputDevice(int index)
                 Joystick *curJoystick = new Joystick(joystick, index, settings, this);
                 joysticks->insert(tempJoystickID, curJoystick);
                 trackjoysticks.insert(tempJoystickID, curJoystick);
-
-                settings->endGroup();
-
-                emit deviceAdded(curJoystick);
+#ifdef WITH_EVDEV
+                attachEvdevDevice(curJoystick);
+#endif
+                device = curJoystick;
             }
+
+            settings->endGroup();
         }
     }
+
+    return device;
 }
 
 #endif
@@ -393,12 +534,58 @@ InputDeviceBitArrayStatus* InputDaemon::createOrGrabBitStatusEntry(QHash<InputDe
     return bitArrayStatus;
 }
 
+/**
+ * @brief Gather the SDL events that are ready to be processed. Events are
+ *     either polled directly or taken from the batch already drained
+ *     by the reader thread.
+ * @param Queue that will receive the pending events
+ */
+void InputDaemon::collectPendingEvents(QQueue<SDL_Event> *pendingEvents)
+{
+    if (eventWorker->isEventDrainEnabled())
+    {
+        eventWorker->takeDrainedEvents(pendingEvents);
+    }
+    else
+    {
+        SDL_Event event;
+        while (SDL_PollEvent(&event) > 0)
+        {
+            pendingEvents->enqueue(event);
+        }
+    }
+
+#ifdef WITH_EVDEV
+    if (evdevWorker)
+    {
+        if (!evdevDevices.isEmpty())
+        {
+            QQueue<SDL_Event> sdlEvents;
+            sdlEvents.swap(*pendingEvents);
+            while (!sdlEvents.isEmpty())
+            {
+                SDL_Event event = sdlEvents.dequeue();
+                if (!isEvdevInputEvent(event))
+                {
+                    pendingEvents->enqueue(event);
+                }
+            }
+        }
+
+        evdevWorker->takeEvents(pendingEvents);
+    }
+#endif
+}
+
 void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 {
-    SDL_Event event;
+    QQueue<SDL_Event> pendingEvents;
+    collectPendingEvents(&pendingEvents);
 
-    while (SDL_PollEvent(&event) > 0)
+    while (!pendingEvents.isEmpty())
     {
+        SDL_Event event = pendingEvents.dequeue();
+
         switch (event.type)
         {
             case SDL_JOYBUTTONDOWN:
@@ -423,6 +610,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
                         pending->changeButtonStatus(event.jbutton.button,
                                                   event.type == SDL_JOYBUTTONDOWN ? true : false);
                         sdlEventQueue->append(event);
+                        queuedAxisEvents.remove(joy);
+                        InputLatencyTracer::recordArrival(joy, event);
+
+                        if (inputRecorder)
+                        {
+                            inputRecorder->recordEvent(joy, event);
+                        }
                     }
                 }
 
@@ -447,7 +641,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeAxesStatus(event.jaxis.axis, !axis->inDeadZone(event.jaxis.value));
-                        sdlEventQueue->append(event);
+                        queueAxisEvent(joy, axis, event.jaxis.value, event, sdlEventQueue);
+                        InputLatencyTracer::recordArrival(joy, event);
+
+                        if (inputRecorder)
+                        {
+                            inputRecorder->recordEvent(joy, event);
+                        }
                     }
                 }
 
@@ -473,6 +673,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeHatStatus(event.jhat.hat, event.jhat.value != 0 ? true : false);
                         sdlEventQueue->append(event);
+                        queuedAxisEvents.remove(joy);
+                        InputLatencyTracer::recordArrival(joy, event);
+
+                        if (inputRecorder)
+                        {
+                            inputRecorder->recordEvent(joy, event);
+                        }
                     }
                 }
 
@@ -502,7 +709,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                         InputDeviceBitArrayStatus *pending = createOrGrabBitStatusEntry(&pendingEventValues, joy);
                         pending->changeAxesStatus(event.caxis.axis, !axis->inDeadZone(event.caxis.value));
-                        sdlEventQueue->append(event);
+                        queueAxisEvent(joy, axis, event.caxis.value, event, sdlEventQueue);
+                        InputLatencyTracer::recordArrival(joy, event);
+
+                        if (inputRecorder)
+                        {
+                            inputRecorder->recordEvent(joy, event);
+                        }
                     }
                 }
                 break;
@@ -526,6 +739,13 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
                         pending->changeButtonStatus(event.cbutton.button,
                                                   event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
                         sdlEventQueue->append(event);
+                        queuedAxisEvents.remove(joy);
+                        InputLatencyTracer::recordArrival(joy, event);
+
+                        if (inputRecorder)
+                        {
+                            inputRecorder->recordEvent(joy, event);
+                        }
                     }
                 }
 
@@ -535,16 +755,148 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
             case SDL_JOYDEVICEADDED:
             {
                 sdlEventQueue->append(event);
+                queuedAxisEvents.clear();
                 break;
             }
 #endif
             case SDL_QUIT:
             {
                 sdlEventQueue->append(event);
+                queuedAxisEvents.clear();
                 break;
             }
         }
     }
+
+    queuedAxisEvents.clear();
+}
+
+/**
+ * @brief Add an axis motion event to the queue of the current poll. When the
+ *     axis already has a motion event waiting and the new value stays in the
+ *     same zone, the waiting event is replaced so the axis is only processed
+ *     once with its newest value. Events that cross the dead zone, or change
+ *     the active direction, are always kept. For a stick axis, the waiting
+ *     event is only replaced when the direction seen at its position and at
+ *     the position of a later event of the other stick axis stay the same.
+ *     Button and hat events of a device end coalescing of its axes so their
+ *     order is preserved.
+ * @param Device that produced the event
+ * @param Axis of the active set
+ * @param Raw axis value
+ * @param SDL event
+ * @param Event queue of the current poll
+ */
+void InputDaemon::queueAxisEvent(InputDevice *device, JoyAxis *axis, int value,
+                                 SDL_Event &event, QQueue<SDL_Event> *sdlEventQueue)
+{
+    QHash<int, QueuedAxisEvent> &deviceEvents = queuedAxisEvents[device];
+
+    JoyAxis *pairedAxis = pairedStickAxis(axis);
+    int pairedValue = 0;
+    if (pairedAxis)
+    {
+        pairedValue = deviceEvents.contains(pairedAxis->getIndex()) ?
+                    deviceEvents.value(pairedAxis->getIndex()).value :
+                    pairedAxis->getCurrentRawValue();
+    }
+
+    bool replace = false;
+    if (deviceEvents.contains(axis->getIndex()))
+    {
+        const QueuedAxisEvent &queued = deviceEvents[axis->getIndex()];
+        replace = axisEventZone(axis, value, queued.pairedValue) == queued.zone;
+
+        if (replace && pairedAxis && deviceEvents.contains(pairedAxis->getIndex()))
+        {
+            const QueuedAxisEvent &pairedQueued = deviceEvents[pairedAxis->getIndex()];
+            if (pairedQueued.queueIndex > queued.queueIndex)
+            {
+                replace = axisEventZone(pairedAxis, pairedQueued.value, value) == pairedQueued.zone;
+            }
+        }
+    }
+
+    if (replace)
+    {
+        QueuedAxisEvent &queued = deviceEvents[axis->getIndex()];
+        (*sdlEventQueue)[queued.queueIndex] = event;
+        queued.value = value;
+
+        // A later event of the other stick axis now sees the new value.
+        if (pairedAxis && deviceEvents.contains(pairedAxis->getIndex()) &&
+            deviceEvents.value(pairedAxis->getIndex()).queueIndex > queued.queueIndex)
+        {
+            deviceEvents[pairedAxis->getIndex()].pairedValue = value;
+        }
+    }
+    else
+    {
+        if (deviceEvents.contains(axis->getIndex()))
+        {
+            // Keep the crossing in order with the motion of the other axes.
+            deviceEvents.clear();
+        }
+
+        QueuedAxisEvent queued;
+        queued.queueIndex = sdlEventQueue->size();
+        queued.value = value;
+        queued.pairedValue = pairedValue;
+        queued.zone = axisEventZone(axis, value, pairedValue);
+        deviceEvents.insert(axis->getIndex(), queued);
+
+        sdlEventQueue->append(event);
+    }
+}
+
+/**
+ * @brief Get the other axis of the stick an axis belongs to.
+ * @param Axis of the active set
+ * @return Other stick axis. NULL if the axis is not part of a stick.
+ */
+JoyAxis* InputDaemon::pairedStickAxis(JoyAxis *axis)
+{
+    JoyAxis *result = 0;
+
+    JoyControlStick *stick = axis->isPartControlStick() ? axis->getControlStick() : 0;
+    if (stick)
+    {
+        result = stick->getAxisX() == axis ? stick->getAxisY() : stick->getAxisX();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Classify an axis value for coalescing. Axes of a stick use the
+ *     direction of the stick, including its diagonal zones, for the value
+ *     along with a value of the other stick axis.
+ * @param Axis of the active set
+ * @param Raw axis value
+ * @param Value of the other stick axis. Ignored for other axes.
+ * @return 0 inside the dead zone. Otherwise the active direction.
+ */
+int InputDaemon::axisEventZone(JoyAxis *axis, int value, int pairedValue)
+{
+    int zone = 0;
+
+    JoyControlStick *stick = axis->isPartControlStick() ? axis->getControlStick() : 0;
+    if (stick)
+    {
+        int axisXValue = stick->getAxisX() == axis ? value : pairedValue;
+        int axisYValue = stick->getAxisX() == axis ? pairedValue : value;
+
+        if (!stick->inDeadZone(axisXValue, axisYValue))
+        {
+            zone = stick->calculateStickDirection(axisXValue, axisYValue);
+        }
+    }
+    else if (!axis->inDeadZone(value))
+    {
+        zone = value < 0 ? -1 : 1;
+    }
+
+    return zone;
 }
 
 #ifdef USE_SDL_2
@@ -693,13 +1045,23 @@ QBitArray InputDaemon::createUnplugEventBitArray(InputDevice *device)
 }
 #endif
 
+/**
+ * @brief Hand the queued events to the elements of their devices. Devices
+ *     do not share element state, but elements, their timers and the mouse
+ *     state in JoyButton belong to the GUI thread. Cursor movement is also
+ *     integrated on the GUI thread by JoyButton::mouseEvent unless a motion
+ *     thread rate is set in Mouse/MotionThreadRate, which is disabled by
+ *     default. Devices are therefore processed one after another here and
+ *     their output is merged once per poll by
+ *     EventHandlerFactory::flushHandlerEvents.
+ * @param Events gathered by firstInputPass
+ */
 void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 {
-    QHash<SDL_JoystickID, InputDevice*> activeDevices;
-
     while (!sdlEventQueue->isEmpty())
     {
         SDL_Event event = sdlEventQueue->dequeue();
+        InputDevice *eventDevice = 0;
 
         switch (event.type)
         {
@@ -719,12 +1081,9 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (button)
                     {
+                        InputLatencyTracer::beginEvent(joy, event);
                         button->joyEvent(event.type == SDL_JOYBUTTONDOWN ? true : false);
-
-                        if (!activeDevices.contains(event.jbutton.which))
-                        {
-                            activeDevices.insert(event.jbutton.which, joy);
-                        }
+                        eventDevice = joy;
                     }
                 }
 
@@ -744,12 +1103,9 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                     JoyAxis *axis = set->getJoyAxis(event.jaxis.axis);
                     if (axis)
                     {
+                        InputLatencyTracer::beginEvent(joy, event);
                         axis->joyEvent(event.jaxis.value);
-
-                        if (!activeDevices.contains(event.jaxis.which))
-                        {
-                            activeDevices.insert(event.jaxis.which, joy);
-                        }
+                        eventDevice = joy;
                     }
                 }
 
@@ -769,12 +1125,9 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                     JoyDPad *dpad = set->getJoyDPad(event.jhat.hat);
                     if (dpad)
                     {
+                        InputLatencyTracer::beginEvent(joy, event);
                         dpad->joyEvent(event.jhat.value);
-
-                        if (!activeDevices.contains(event.jhat.which))
-                        {
-                            activeDevices.insert(event.jhat.which, joy);
-                        }
+                        eventDevice = joy;
                     }
                 }
 
@@ -791,14 +1144,11 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                     JoyAxis *axis = set->getJoyAxis(event.caxis.axis);
                     if (axis)
                     {
+                        InputLatencyTracer::beginEvent(joy, event);
                         //qDebug() << QTime::currentTime() << ": " << "Axis " << event.caxis.axis+1
                         //         << ": " << event.caxis.value;
                         axis->joyEvent(event.caxis.value);
-
-                        if (!activeDevices.contains(event.caxis.which))
-                        {
-                            activeDevices.insert(event.caxis.which, joy);
-                        }
+                        eventDevice = joy;
                     }
                 }
                 break;
@@ -815,12 +1165,9 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
                     if (button)
                     {
+                        InputLatencyTracer::beginEvent(joy, event);
                         button->joyEvent(event.type == SDL_CONTROLLERBUTTONDOWN ? true : false);
-
-                        if (!activeDevices.contains(event.cbutton.which))
-                        {
-                            activeDevices.insert(event.cbutton.which, joy);
-                        }
+                        eventDevice = joy;
                     }
                 }
 
@@ -857,14 +1204,16 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                 break;
         }
 
-        // Active possible queued stick and vdpad events.
-        QHashIterator<SDL_JoystickID, InputDevice*> activeDevIter(activeDevices);
-        while (activeDevIter.hasNext())
+        // Active possible queued stick and vdpad events. Elements only
+        // queue events for their own device and earlier devices were
+        // handled after their own events, so only check this device.
+        if (eventDevice)
         {
-            InputDevice *tempDevice = activeDevIter.next().value();
-            tempDevice->activatePossibleControlStickEvents();
-            tempDevice->activatePossibleVDPadEvents();
+            eventDevice->activatePossibleControlStickEvents();
+            eventDevice->activatePossibleVDPadEvents();
         }
+
+        InputLatencyTracer::endEvent();
     }
 }
 
@@ -900,4 +1249,158 @@ void InputDaemon::clearBitArrayStatusInstances()
 void InputDaemon::resetActiveButtonMouseDistances()
 {
     JoyButton::resetActiveButtonMouseDistances();
+
+    if (JoyButton::getPendingMouseButtons()->isEmpty())
+    {
+        pollResetTimer.stop();
+    }
+}
+
+#ifdef WITH_EVDEV
+/**
+ * @brief Start reading controller input through evdev on a dedicated
+ *     thread. SDL keeps handling devices that cannot be opened.
+ */
+void InputDaemon::startEvdevWorker()
+{
+    evdevWorker = new EvdevEventReader();
+    if (evdevWorker->isOpen())
+    {
+        evdevThread = new QThread();
+        evdevWorker->moveToThread(evdevThread);
+        connect(evdevThread, SIGNAL(started()), evdevWorker, SLOT(performWork()));
+        connect(evdevWorker, SIGNAL(eventRaised()), this, SLOT(run()));
+        evdevThread->start(QThread::TimeCriticalPriority);
+    }
+    else
+    {
+        Logger::LogWarning(tr("Could not initialize evdev input. Using SDL input."));
+        delete evdevWorker;
+        evdevWorker = 0;
+    }
+}
+
+void InputDaemon::stopEvdevWorker()
+{
+    if (evdevWorker)
+    {
+        disconnect(evdevWorker, SIGNAL(eventRaised()), this, 0);
+        evdevWorker->stop();
+
+        evdevThread->quit();
+        evdevThread->wait();
+
+        delete evdevWorker;
+        evdevWorker = 0;
+        delete evdevThread;
+        evdevThread = 0;
+
+        evdevDevices.clear();
+        updateSDLInputEventState();
+    }
 }
+
+void InputDaemon::attachEvdevDevice(InputDevice *device)
+{
+    if (evdevWorker && evdevWorker->addDevice(device))
+    {
+        evdevDevices.insert(device->getSDLJoystickID());
+        Logger::LogInfo(QString("Reading joystick #%1 through evdev").arg(device->getRealJoyNumber()));
+    }
+
+    updateSDLInputEventState();
+}
+
+void InputDaemon::detachEvdevDevice(SDL_JoystickID deviceID)
+{
+    if (evdevWorker && evdevDevices.contains(deviceID))
+    {
+        evdevDevices.remove(deviceID);
+        evdevWorker->removeDevice(deviceID);
+    }
+
+    updateSDLInputEventState();
+}
+
+/**
+ * @brief Stop SDL from queueing input events while every open device is
+ *     read through evdev. SDL keeps reading the nodes of the devices it
+ *     has opened in SDL_JoystickUpdate. It offers no way to skip a single
+ *     device while still reporting its removal, and devices have to stay
+ *     open through SDL for their game controller mapping. Input events
+ *     can only be disabled for all devices, so this is only done when no
+ *     device depends on SDL input. Device added and removed events are
+ *     kept so hotplug still works. Events of evdev devices that SDL still
+ *     queues otherwise are dropped by isEvdevInputEvent.
+ */
+void InputDaemon::updateSDLInputEventState()
+{
+    bool ignoreEvents = evdevWorker && !evdevDevices.isEmpty();
+
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
+    while (iter.hasNext() && ignoreEvents)
+    {
+        ignoreEvents = evdevDevices.contains(iter.next().key());
+    }
+
+    if (ignoreEvents != sdlInputEventsIgnored)
+    {
+        int state = ignoreEvents ? SDL_IGNORE : SDL_ENABLE;
+        SDL_EventState(SDL_JOYAXISMOTION, state);
+        SDL_EventState(SDL_JOYBALLMOTION, state);
+        SDL_EventState(SDL_JOYHATMOTION, state);
+        SDL_EventState(SDL_JOYBUTTONDOWN, state);
+        SDL_EventState(SDL_JOYBUTTONUP, state);
+        SDL_EventState(SDL_CONTROLLERAXISMOTION, state);
+        SDL_EventState(SDL_CONTROLLERBUTTONDOWN, state);
+        SDL_EventState(SDL_CONTROLLERBUTTONUP, state);
+
+        sdlInputEventsIgnored = ignoreEvents;
+        Logger::LogDebug(QString("SDL input events %1").arg(ignoreEvents ? "disabled" : "enabled"));
+    }
+}
+
+/**
+ * @brief Check if an SDL event carries input of a device that is read
+ *     through evdev.
+ * @param SDL event
+ * @return Whether the event duplicates evdev input
+ */
+bool InputDaemon::isEvdevInputEvent(const SDL_Event &event)
+{
+    bool result = false;
+
+    switch (event.type)
+    {
+        case SDL_JOYAXISMOTION:
+        {
+            result = evdevDevices.contains(event.jaxis.which);
+            break;
+        }
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        {
+            result = evdevDevices.contains(event.jbutton.which);
+            break;
+        }
+        case SDL_JOYHATMOTION:
+        {
+            result = evdevDevices.contains(event.jhat.which);
+            break;
+        }
+        case SDL_CONTROLLERAXISMOTION:
+        {
+            result = evdevDevices.contains(event.caxis.which);
+            break;
+        }
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        {
+            result = evdevDevices.contains(event.cbutton.which);
+            break;
+        }
+    }
+
+    return result;
+}
+#endif
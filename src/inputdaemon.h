@@ -21,6 +21,12 @@
 #include "sdleventreader.h"
 #include "antimicrosettings.h"
 #include "inputdevicebitarraystatus.h"
+#include "inputtracerecorder.h"
+
+#ifdef WITH_EVDEV
+#include <QSet>
+#include "evdeveventreader.h"
+#endif
 
 
 class InputDaemon : public QObject
@@ -31,19 +37,37 @@ public:
     ~InputDaemon();
 
     void startWorker();
+    void setInputRecorder(InputTraceRecorder *recorder);
 
 protected:
     InputDeviceBitArrayStatus* createOrGrabBitStatusEntry(
             QHash<InputDevice*, InputDeviceBitArrayStatus*> *statusHash,
             InputDevice *device, bool readCurrent=true);
 
+    void startWorkerThread();
+#ifdef WITH_EVDEV
+    void startEvdevWorker();
+    void stopEvdevWorker();
+    void attachEvdevDevice(InputDevice *device);
+    void detachEvdevDevice(SDL_JoystickID deviceID);
+    bool isEvdevInputEvent(const SDL_Event &event);
+    void updateSDLInputEventState();
+#endif
+    void collectPendingEvents(QQueue<SDL_Event> *pendingEvents);
     void firstInputPass(QQueue<SDL_Event> *sdlEventQueue);
     void secondInputPass(QQueue<SDL_Event> *sdlEventQueue);
 #ifdef USE_SDL_2
     void modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue);
     QBitArray createUnplugEventBitArray(InputDevice *device);
+    SDL_JoystickID getDeviceInstanceID(int index);
+    InputDevice* openInputDevice(int index);
 #endif
 
+    void queueAxisEvent(InputDevice *device, JoyAxis *axis, int value,
+                        SDL_Event &event, QQueue<SDL_Event> *sdlEventQueue);
+    JoyAxis* pairedStickAxis(JoyAxis *axis);
+    int axisEventZone(JoyAxis *axis, int value, int pairedValue);
+
     void clearBitArrayStatusInstances();
 
     QMap<SDL_JoystickID, InputDevice*> *joysticks;
@@ -57,14 +81,39 @@ protected:
     QHash<InputDevice*, InputDeviceBitArrayStatus*> releaseEventsGenerated;
     QHash<InputDevice*, InputDeviceBitArrayStatus*> pendingEventValues;
 
+    // Newest motion event of an axis that is still waiting in the event
+    // queue of the current poll.
+    struct QueuedAxisEvent {
+        int queueIndex;
+        int value;
+        // Value of the other axis of a stick at the queue position.
+        int pairedValue;
+        int zone;
+    };
+
+    // Queued axis motion per device and axis index. Only filled while
+    // the first input pass runs.
+    QHash<InputDevice*, QHash<int, QueuedAxisEvent> > queuedAxisEvents;
+
     bool stopped;
     bool graphical;
 
     SDLEventReader *eventWorker;
     QThread *thread;
     AntiMicroSettings *settings;
+    InputTraceRecorder *inputRecorder;
     QTimer pollResetTimer;
 
+#ifdef WITH_EVDEV
+    EvdevEventReader *evdevWorker;
+    QThread *evdevThread;
+    // Devices whose input is read through evdev. SDL input events of
+    // these devices are ignored.
+    QSet<SDL_JoystickID> evdevDevices;
+    // SDL input events are disabled because every device uses evdev.
+    bool sdlInputEventsIgnored;
+#endif
+
     static const int GAMECONTROLLERTRIGGERRELEASE;
 
 signals:
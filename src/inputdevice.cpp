@@ -61,9 +61,10 @@ void InputDevice::reset()
     deviceEdited = false;
     profileName = "";
 
-    for (int i=0; i < NUMBER_JOYSETS; i++)
+    QHashIterator<int, SetJoystick*> iter(joystick_sets);
+    while (iter.hasNext())
     {
-        SetJoystick* set = joystick_sets.value(i);
+        SetJoystick* set = iter.next().value();
         set->reset();
     }
 }
@@ -173,12 +174,13 @@ void InputDevice::setActiveSetNumber(int index)
             vdpadstates.append(dpad->getCurrentDirection());
         }
 
-        // Release all current pressed elements and change set number
-        joystick_sets.value(active_set)->release();
+        // Release all current pressed elements and change set number.
+        // Elements that are already neutral are skipped.
+        old_set->releaseActive();
         active_set = index;
 
         // Activate all buttons in the switched set
-        current_set = joystick_sets.value(active_set);
+        current_set = getSetJoystick(active_set);
 
         for (int i=0; i < current_set->getNumberSticks(); i++)
         {
@@ -411,7 +413,12 @@ void InputDevice::setActiveSetNumber(int index)
                 }
             }
 
-            button->joyEvent(value, tempignore);
+            // Buttons in an inactive set are left released. Only pressed
+            // buttons need an event.
+            if (value || !button->isNeutral())
+            {
+                button->joyEvent(value, tempignore);
+            }
         }
 
         // Activate all axis buttons in the switched set
@@ -449,7 +456,11 @@ void InputDevice::setActiveSetNumber(int index)
                 axis->getNAxisButton()->setWhileHeldStatus(false);
             }
 
-            axis->joyEvent(value, tempignore);
+            // Skip axes that already rest at the current value.
+            if (value != axis->getCurrentRawValue() || !axis->isNeutral())
+            {
+                axis->joyEvent(value, tempignore);
+            }
         }
 
         // Activate all dpad buttons in the switched set
@@ -556,7 +567,10 @@ void InputDevice::setActiveSetNumber(int index)
                 }
             }
 
-            dpad->joyEvent(value, tempignore);
+            if (value || !dpad->isNeutral())
+            {
+                dpad->joyEvent(value, tempignore);
+            }
         }
 
         activatePossibleControlStickEvents();
@@ -599,7 +613,39 @@ int InputDevice::getNumberVDPads()
     return getActiveSetJoystick()->getNumberVDPads();
 }
 
+/**
+ * @brief Get a set of the device. Sets other than the first one are created
+ *     the first time they are requested and receive the sticks, virtual
+ *     dpads, element names and axis throttles of the first set.
+ * @param Set index
+ * @return Set or NULL if the index is out of range
+ */
 SetJoystick* InputDevice::getSetJoystick(int index)
+{
+    SetJoystick *set = joystick_sets.value(index);
+    if (!set && index >= 0 && index < NUMBER_JOYSETS)
+    {
+        set = createSetJoystick(index);
+
+        SetJoystick *firstSet = joystick_sets.value(0);
+        if (firstSet)
+        {
+            firstSet->copyStructure(set);
+        }
+
+        joystick_sets.insert(index, set);
+        enableSetConnections(set);
+    }
+
+    return set;
+}
+
+/**
+ * @brief Get a set of the device without creating it.
+ * @param Set index
+ * @return Set or NULL if the set has not been used yet
+ */
+SetJoystick* InputDevice::findSetJoystick(int index)
 {
     return joystick_sets.value(index);
 }
@@ -611,7 +657,7 @@ void InputDevice::propogateSetChange(int index)
 
 void InputDevice::changeSetButtonAssociation(int button_index, int originset, int newset, int mode)
 {
-    JoyButton *button = joystick_sets.value(newset)->getJoyButton(button_index);
+    JoyButton *button = getSetJoystick(newset)->getJoyButton(button_index);
     JoyButton::SetChangeCondition tempmode = (JoyButton::SetChangeCondition)mode;
     button->setChangeSetSelection(originset);
     button->setChangeSetCondition(tempmode, true);
@@ -637,9 +683,9 @@ void InputDevice::readConfig(QXmlStreamReader *xml)
                     {
                         int index = xml->attributes().value("index").toString().toInt();
                         index = index - 1;
-                        if (index >= 0 && index < joystick_sets.size())
+                        if (index >= 0 && index < NUMBER_JOYSETS)
                         {
-                            joystick_sets.value(index)->readConfig(xml);
+                            getSetJoystick(index)->readConfig(xml);
                         }
                     }
                     else
@@ -663,14 +709,15 @@ void InputDevice::readConfig(QXmlStreamReader *xml)
                     yAxis -= 1;
                     stickIndex -= 1;
 
-                    for (int i=0; i <joystick_sets.size(); i++)
+                    QHashIterator<int, SetJoystick*> iter(joystick_sets);
+                    while (iter.hasNext())
                     {
-                        SetJoystick *currentset = joystick_sets.value(i);
+                        SetJoystick *currentset = iter.next().value();
                         JoyAxis *axis1 = currentset->getJoyAxis(xAxis);
                         JoyAxis *axis2 = currentset->getJoyAxis(yAxis);
                         if (axis1 && axis2)
                         {
-                            JoyControlStick *stick = new JoyControlStick(axis1, axis2, stickIndex, i, this);
+                            JoyControlStick *stick = new JoyControlStick(axis1, axis2, stickIndex, currentset->getIndex(), this);
                             currentset->addControlStick(stickIndex, stick);
                         }
                     }
@@ -687,13 +734,14 @@ void InputDevice::readConfig(QXmlStreamReader *xml)
                 int vdpadIndex = xml->attributes().value("index").toString().toInt();
                 if (vdpadIndex > 0)
                 {
-                    for (int i=0; i <joystick_sets.size(); i++)
+                    QHashIterator<int, SetJoystick*> iter(joystick_sets);
+                    while (iter.hasNext())
                     {
-                        SetJoystick *currentset = joystick_sets.value(i);
+                        SetJoystick *currentset = iter.next().value();
                         VDPad *vdpad = currentset->getVDPad(vdpadIndex-1);
                         if (!vdpad)
                         {
-                            vdpad = new VDPad(vdpadIndex-1, i, currentset);
+                            vdpad = new VDPad(vdpadIndex-1, currentset->getIndex(), currentset);
                             currentset->addVDPad(vdpadIndex-1, vdpad);
                         }
                     }
@@ -710,9 +758,10 @@ void InputDevice::readConfig(QXmlStreamReader *xml)
                             if (vdpadAxisIndex > 0 && vdpadDirection > 0)
                             {
                                 vdpadAxisIndex -= 1;
-                                for (int i=0; i < joystick_sets.size(); i++)
+                                QHashIterator<int, SetJoystick*> setIter(joystick_sets);
+                                while (setIter.hasNext())
                                 {
-                                    SetJoystick *currentset = joystick_sets.value(i);
+                                    SetJoystick *currentset = setIter.next().value();
                                     VDPad *vdpad = currentset->getVDPad(vdpadIndex-1);
                                     if (vdpad)
                                     {
@@ -741,9 +790,10 @@ void InputDevice::readConfig(QXmlStreamReader *xml)
                             {
                                 vdpadButtonIndex -= 1;
 
-                                for (int i=0; i < joystick_sets.size(); i++)
+                                QHashIterator<int, SetJoystick*> setIter(joystick_sets);
+                                while (setIter.hasNext())
                                 {
-                                    SetJoystick *currentset = joystick_sets.value(i);
+                                    SetJoystick *currentset = setIter.next().value();
                                     VDPad *vdpad = currentset->getVDPad(vdpadIndex-1);
                                     if (vdpad)
                                     {
@@ -766,9 +816,10 @@ void InputDevice::readConfig(QXmlStreamReader *xml)
                     }
                 }
 
-                for (int i=0; i < joystick_sets.size(); i++)
+                QHashIterator<int, SetJoystick*> iter(joystick_sets);
+                while (iter.hasNext())
                 {
-                    SetJoystick *currentset = joystick_sets.value(i);
+                    SetJoystick *currentset = iter.next().value();
                     for (int j=0; j < currentset->getNumberVDPads(); j++)
                     {
                         VDPad *vdpad = currentset->getVDPad(j);
@@ -1189,9 +1240,13 @@ void InputDevice::writeConfig(QXmlStreamWriter *xml)
     }
 
     xml->writeStartElement("sets");
-    for (int i=0; i < joystick_sets.size(); i++)
+    for (int i=0; i < NUMBER_JOYSETS; i++)
     {
-        joystick_sets.value(i)->writeConfig(xml);
+        SetJoystick *currentSet = findSetJoystick(i);
+        if (currentSet)
+        {
+            currentSet->writeConfig(xml);
+        }
     }
     xml->writeEndElement();
 
@@ -1203,11 +1258,11 @@ void InputDevice::changeSetAxisButtonAssociation(int button_index, int axis_inde
     JoyAxisButton *button = 0;
     if (button_index == 0)
     {
-        button = joystick_sets.value(newset)->getJoyAxis(axis_index)->getNAxisButton();
+        button = getSetJoystick(newset)->getJoyAxis(axis_index)->getNAxisButton();
     }
     else if (button_index == 1)
     {
-        button = joystick_sets.value(newset)->getJoyAxis(axis_index)->getPAxisButton();
+        button = getSetJoystick(newset)->getJoyAxis(axis_index)->getPAxisButton();
     }
 
     JoyButton::SetChangeCondition tempmode = (JoyButton::SetChangeCondition)mode;
@@ -1217,7 +1272,7 @@ void InputDevice::changeSetAxisButtonAssociation(int button_index, int axis_inde
 
 void InputDevice::changeSetStickButtonAssociation(int button_index, int stick_index, int originset, int newset, int mode)
 {
-    JoyControlStickButton *button = joystick_sets.value(newset)->getJoyStick(stick_index)->getDirectionButton((JoyControlStick::JoyStickDirections)button_index);
+    JoyControlStickButton *button = getSetJoystick(newset)->getJoyStick(stick_index)->getDirectionButton((JoyControlStick::JoyStickDirections)button_index);
 
     JoyButton::SetChangeCondition tempmode = (JoyButton::SetChangeCondition)mode;
     button->setChangeSetSelection(originset);
@@ -1226,7 +1281,7 @@ void InputDevice::changeSetStickButtonAssociation(int button_index, int stick_in
 
 void InputDevice::changeSetDPadButtonAssociation(int button_index, int dpad_index, int originset, int newset, int mode)
 {
-    JoyDPadButton *button = joystick_sets.value(newset)->getJoyDPad(dpad_index)->getJoyButton(button_index);
+    JoyDPadButton *button = getSetJoystick(newset)->getJoyDPad(dpad_index)->getJoyButton(button_index);
 
     JoyButton::SetChangeCondition tempmode = (JoyButton::SetChangeCondition)mode;
     button->setChangeSetSelection(originset);
@@ -1235,7 +1290,7 @@ void InputDevice::changeSetDPadButtonAssociation(int button_index, int dpad_inde
 
 void InputDevice::changeSetVDPadButtonAssociation(int button_index, int dpad_index, int originset, int newset, int mode)
 {
-    JoyDPadButton *button = joystick_sets.value(newset)->getVDPad(dpad_index)->getJoyButton(button_index);
+    JoyDPadButton *button = getSetJoystick(newset)->getVDPad(dpad_index)->getJoyButton(button_index);
 
     JoyButton::SetChangeCondition tempmode = (JoyButton::SetChangeCondition)mode;
     button->setChangeSetSelection(originset);
@@ -1269,9 +1324,10 @@ void InputDevice::propogateSetAxisThrottleChange(int index, int originset)
 
 void InputDevice::removeControlStick(int index)
 {
-    for (int i=0; i < NUMBER_JOYSETS; i++)
+    QHashIterator<int, SetJoystick*> iter(joystick_sets);
+    while (iter.hasNext())
     {
-        SetJoystick *currentset = getSetJoystick(i);
+        SetJoystick *currentset = iter.next().value();
         if (currentset->getJoyStick(index))
         {
             currentset->removeControlStick(index);
@@ -1902,9 +1958,10 @@ void InputDevice::setCalibrationThrottle(int axisNum, JoyAxis::ThrottleTypes thr
 {
     if (!cali.contains(axisNum))
     {
-        for (int i=0; i < NUMBER_JOYSETS; i++)
+        QHashIterator<int, SetJoystick*> iter(joystick_sets);
+        while (iter.hasNext())
         {
-            joystick_sets.value(i)->setAxisThrottle(axisNum, throttle);
+            iter.next().value()->setAxisThrottle(axisNum, throttle);
         }
 
         cali.insert(axisNum, throttle);
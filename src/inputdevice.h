@@ -36,6 +36,7 @@ public:
     int getActiveSetNumber();
     SetJoystick* getActiveSetJoystick();
     SetJoystick* getSetJoystick(int index);
+    SetJoystick* findSetJoystick(int index);
     void removeControlStick(int index);
     bool isActive();
     int getButtonDownCount();
@@ -106,6 +107,7 @@ public:
     static const unsigned int DEFAULTKEYREPEATRATE;
 
 protected:
+    virtual SetJoystick* createSetJoystick(int index) = 0;
     void enableSetConnections(SetJoystick *setstick);
     bool elementsHaveNames();
 
@@ -0,0 +1,335 @@
+//#include <QDebug>
+#include <QTextStream>
+#include <QMapIterator>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+
+#ifdef USE_SDL_2
+#include <SDL2/SDL_timer.h>
+#else
+#include <SDL/SDL_timer.h>
+#endif
+
+#include "inputlatencytracer.h"
+#include "inputdevice.h"
+
+InputLatencyTracer* InputLatencyTracer::_instance = 0;
+bool InputLatencyTracer::enabled = false;
+InputLatencyTracer::TraceContext* InputLatencyTracer::currentContext = 0;
+
+const int InputLatencyTracer::SAMPLE_HISTORY_SIZE = 4096;
+
+InputLatencyTracer::InputLatencyTracer(QObject *parent) :
+    QObject(parent)
+{
+    clock.start();
+}
+
+InputLatencyTracer::~InputLatencyTracer()
+{
+    reset();
+}
+
+InputLatencyTracer* InputLatencyTracer::getInstance()
+{
+    if (!_instance)
+    {
+        _instance = new InputLatencyTracer();
+    }
+
+    return _instance;
+}
+
+void InputLatencyTracer::deleteInstance()
+{
+    if (_instance)
+    {
+        delete _instance;
+        _instance = 0;
+    }
+
+    currentContext = 0;
+}
+
+/**
+ * @brief Toggle collection of latency samples. Tracing is off by default
+ *     so the hooks in the input path only cost a flag check.
+ * @param Tracing status
+ */
+void InputLatencyTracer::setEnabled(bool enabled)
+{
+    InputLatencyTracer::enabled = enabled;
+    if (!enabled)
+    {
+        currentContext = 0;
+    }
+}
+
+/**
+ * @brief Record how long an event sat in the SDL queue before
+ *     InputDaemon picked it up.
+ * @param Device that produced the event
+ * @param SDL event
+ */
+void InputLatencyTracer::recordArrival(InputDevice *device, const SDL_Event &event)
+{
+    if (enabled && device)
+    {
+        InputLatencyTracer *tracer = getInstance();
+        QMutexLocker locker(&tracer->statsMutex);
+
+        int deviceKey = device->getRealJoyNumber();
+        DeviceStatistics *stats = tracer->deviceStatistics(deviceKey);
+        if (stats->name.isEmpty())
+        {
+            stats->name = device->getSDLName();
+        }
+
+        tracer->addSample(deviceKey, StageSDLQueue, tracer->sdlQueueDelay(event));
+    }
+}
+
+/**
+ * @brief Start tracing the dispatch of an event. Later stages are measured
+ *     from the moment SDL stamped the event.
+ * @param Device that produced the event
+ * @param SDL event
+ */
+void InputLatencyTracer::beginEvent(InputDevice *device, const SDL_Event &event)
+{
+    if (enabled && device)
+    {
+        InputLatencyTracer *tracer = getInstance();
+        TraceContext &context = tracer->eventContext;
+
+        context.deviceKey = device->getRealJoyNumber();
+        context.origin = (tracer->clock.nsecsElapsed() / 1000) -
+                tracer->sdlQueueDelay(event);
+        context.recordedStages = 1 << StageSDLQueue;
+        currentContext = &context;
+    }
+}
+
+void InputLatencyTracer::endEvent()
+{
+    currentContext = 0;
+}
+
+/**
+ * @brief Copy the context of the event being dispatched so that work
+ *     scheduled through a timer can be attributed to it.
+ * @param Storage for the copied context
+ */
+void InputLatencyTracer::captureEvent(TraceContext *context)
+{
+    if (enabled && currentContext)
+    {
+        *context = *currentContext;
+    }
+    else
+    {
+        context->deviceKey = -1;
+    }
+}
+
+void InputLatencyTracer::recordStage(TraceStage stage)
+{
+    unsigned int stageFlag = 1 << stage;
+    if (currentContext->deviceKey >= 0 && !(currentContext->recordedStages & stageFlag))
+    {
+        currentContext->recordedStages |= stageFlag;
+        qint64 latency = (clock.nsecsElapsed() / 1000) - currentContext->origin;
+
+        QMutexLocker locker(&statsMutex);
+        addSample(currentContext->deviceKey, stage, latency);
+    }
+}
+
+void InputLatencyTracer::addSample(int deviceKey, TraceStage stage, qint64 latency)
+{
+    StageStatistics &stats = deviceStatistics(deviceKey)->stages[stage];
+    if (stats.samples.size() < SAMPLE_HISTORY_SIZE)
+    {
+        stats.samples.append(latency);
+    }
+    else
+    {
+        stats.samples[stats.nextIndex] = latency;
+    }
+
+    stats.nextIndex = (stats.nextIndex + 1) % SAMPLE_HISTORY_SIZE;
+    stats.count++;
+    stats.maximum = qMax(stats.maximum, latency);
+}
+
+InputLatencyTracer::DeviceStatistics* InputLatencyTracer::deviceStatistics(int deviceKey)
+{
+    DeviceStatistics *stats = devices.value(deviceKey);
+    if (!stats)
+    {
+        stats = new DeviceStatistics();
+        devices.insert(deviceKey, stats);
+    }
+
+    return stats;
+}
+
+/**
+ * @brief Convert the SDL event timestamp into the time the event has been
+ *     waiting. SDL only provides millisecond resolution. SDL 1.2 events
+ *     are not timestamped so the delay is reported as zero.
+ * @param SDL event
+ * @return Delay in microseconds
+ */
+qint64 InputLatencyTracer::sdlQueueDelay(const SDL_Event &event)
+{
+    qint64 delay = 0;
+
+#ifdef USE_SDL_2
+    Uint32 currentTicks = SDL_GetTicks();
+    if (event.common.timestamp > 0 && currentTicks >= event.common.timestamp)
+    {
+        delay = static_cast<qint64>(currentTicks - event.common.timestamp) * 1000;
+    }
+#else
+    Q_UNUSED(event);
+#endif
+
+    return delay;
+}
+
+QString InputLatencyTracer::stageName(TraceStage stage)
+{
+    QString temp;
+    if (stage == StageSDLQueue)
+    {
+        temp = tr("SDL queue");
+    }
+    else if (stage == StageJoyEvent)
+    {
+        temp = tr("Button event");
+    }
+    else if (stage == StageActivateSlots)
+    {
+        temp = tr("Slot activation");
+    }
+    else if (stage == StageEventOutput)
+    {
+        temp = tr("Event output");
+    }
+
+    return temp;
+}
+
+QString InputLatencyTracer::generateStageLine(TraceStage stage, QVector<qint64> samples,
+                                             qint64 count, qint64 maximum)
+{
+    QString temp = QString("  %1").arg(stageName(stage).leftJustified(18, ' '));
+
+    if (samples.isEmpty())
+    {
+        temp.append(tr("no samples"));
+    }
+    else
+    {
+        qSort(samples);
+        qint64 p50 = samples.at((samples.size() - 1) * 50 / 100);
+        qint64 p99 = samples.at((samples.size() - 1) * 99 / 100);
+
+        temp.append(QString::number(count).rightJustified(9, ' '))
+            .append(QString::number(p50).rightJustified(10, ' '))
+            .append(QString::number(p99).rightJustified(10, ' '))
+            .append(QString::number(maximum).rightJustified(10, ' '));
+    }
+
+    return temp;
+}
+
+/**
+ * @brief Build a table of collected latencies. Every stage is measured
+ *     from the SDL event timestamp. Percentiles are taken over the most
+ *     recent samples while the sample count and maximum cover the whole
+ *     session.
+ * @return Report text
+ */
+QString InputLatencyTracer::generateReport()
+{
+    QMutexLocker locker(&statsMutex);
+
+    QString report;
+    QTextStream out(&report);
+    QString header = QString("  %1%2%3%4%5").arg(tr("Stage").leftJustified(18, ' '))
+            .arg(tr("Samples").rightJustified(9, ' '))
+            .arg(tr("p50 (us)").rightJustified(10, ' '))
+            .arg(tr("p99 (us)").rightJustified(10, ' '))
+            .arg(tr("Max (us)").rightJustified(10, ' '));
+
+    out << tr("Input latency report") << endl;
+
+    if (devices.isEmpty())
+    {
+        out << tr("No latency samples have been collected.") << endl;
+        return report;
+    }
+
+    QVector<qint64> combinedSamples[NumTraceStages];
+    qint64 combinedCount[NumTraceStages] = {0};
+    qint64 combinedMaximum[NumTraceStages] = {0};
+
+    QMapIterator<int, DeviceStatistics*> iter(devices);
+    while (iter.hasNext())
+    {
+        iter.next();
+        DeviceStatistics *device = iter.value();
+
+        out << endl << tr("Controller #%1: %2").arg(iter.key()).arg(device->name) << endl;
+        out << header << endl;
+
+        for (int i = 0; i < NumTraceStages; i++)
+        {
+            StageStatistics &stats = device->stages[i];
+            out << generateStageLine(static_cast<TraceStage>(i), stats.samples,
+                                     stats.count, stats.maximum) << endl;
+
+            combinedSamples[i] += stats.samples;
+            combinedCount[i] += stats.count;
+            combinedMaximum[i] = qMax(combinedMaximum[i], stats.maximum);
+        }
+    }
+
+    if (devices.size() > 1)
+    {
+        out << endl << tr("All controllers") << endl;
+        out << header << endl;
+
+        for (int i = 0; i < NumTraceStages; i++)
+        {
+            out << generateStageLine(static_cast<TraceStage>(i), combinedSamples[i],
+                                     combinedCount[i], combinedMaximum[i]) << endl;
+        }
+    }
+
+    return report;
+}
+
+void InputLatencyTracer::reset()
+{
+    QMutexLocker locker(&statsMutex);
+
+    qDeleteAll(devices);
+    devices.clear();
+}
+
+InputLatencyTracer::ContextScope::ContextScope(TraceContext *context)
+{
+    previousContext = currentContext;
+    if (enabled && context->deviceKey >= 0)
+    {
+        currentContext = context;
+    }
+}
+
+InputLatencyTracer::ContextScope::~ContextScope()
+{
+    currentContext = previousContext;
+}
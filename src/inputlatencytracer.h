@@ -0,0 +1,118 @@
+#ifndef INPUTLATENCYTRACER_H
+#define INPUTLATENCYTRACER_H
+
+#include <QObject>
+#include <QString>
+#include <QMap>
+#include <QVector>
+#include <QMutex>
+#include <QElapsedTimer>
+
+#ifdef USE_SDL_2
+#include <SDL2/SDL_events.h>
+#else
+#include <SDL/SDL_events.h>
+#endif
+
+class InputDevice;
+
+class InputLatencyTracer : public QObject
+{
+    Q_OBJECT
+public:
+    enum TraceStage
+    {
+        StageSDLQueue = 0, StageJoyEvent, StageActivateSlots, StageEventOutput,
+        NumTraceStages
+    };
+
+    // Per event trace state. Buttons keep a copy so that slots activated
+    // later by a timer can still be attributed to the press that caused them.
+    struct TraceContext {
+        TraceContext() : deviceKey(-1), origin(0), recordedStages(0) {}
+
+        int deviceKey;
+        qint64 origin;
+        unsigned int recordedStages;
+    };
+
+    // Make the context of a button active for the lifetime of the object.
+    class ContextScope
+    {
+    public:
+        explicit ContextScope(TraceContext *context);
+        ~ContextScope();
+
+    private:
+        TraceContext *previousContext;
+    };
+
+    static InputLatencyTracer* getInstance();
+    void deleteInstance();
+
+    static void setEnabled(bool enabled);
+    inline static bool isEnabled()
+    {
+        return enabled;
+    }
+
+    static void recordArrival(InputDevice *device, const SDL_Event &event);
+    static void beginEvent(InputDevice *device, const SDL_Event &event);
+    static void endEvent();
+    static void captureEvent(TraceContext *context);
+
+    inline static void markStage(TraceStage stage)
+    {
+        if (enabled && currentContext)
+        {
+            getInstance()->recordStage(stage);
+        }
+    }
+
+    QString generateReport();
+    void reset();
+
+    static const int SAMPLE_HISTORY_SIZE;
+
+protected:
+    explicit InputLatencyTracer(QObject *parent = 0);
+    ~InputLatencyTracer();
+
+    struct StageStatistics {
+        StageStatistics() : nextIndex(0), count(0), maximum(0) {}
+
+        QVector<qint64> samples;
+        int nextIndex;
+        qint64 count;
+        qint64 maximum;
+    };
+
+    struct DeviceStatistics {
+        QString name;
+        StageStatistics stages[NumTraceStages];
+    };
+
+    void recordStage(TraceStage stage);
+    void addSample(int deviceKey, TraceStage stage, qint64 latency);
+    DeviceStatistics* deviceStatistics(int deviceKey);
+    qint64 sdlQueueDelay(const SDL_Event &event);
+    QString stageName(TraceStage stage);
+    QString generateStageLine(TraceStage stage, QVector<qint64> samples,
+                              qint64 count, qint64 maximum);
+
+    static InputLatencyTracer *_instance;
+    static bool enabled;
+    static TraceContext *currentContext;
+
+    TraceContext eventContext;
+    QElapsedTimer clock;
+    QMap<int, DeviceStatistics*> devices;
+    QMutex statsMutex;
+
+signals:
+
+public slots:
+
+};
+
+#endif // INPUTLATENCYTRACER_H
@@ -0,0 +1,172 @@
+#include <QObject>
+#include <QFile>
+#include <QDataStream>
+#include <cstring>
+
+#include "inputtrace.h"
+
+namespace InputTrace
+{
+    /**
+     * @brief Load a complete trace file into memory.
+     * @param Location of the trace file
+     * @param List that will receive the device records
+     * @param List that will receive the event records
+     * @param Description of the problem if the file could not be read
+     * @return Whether the trace was read successfully
+     */
+    bool readTraceFile(const QString &fileName, QList<TraceDevice> &devices,
+                       QList<TraceEvent> &events, QString &errorString)
+    {
+        QFile traceFile(fileName);
+        if (!traceFile.open(QIODevice::ReadOnly))
+        {
+            errorString = QObject::tr("Could not open trace file %1.").arg(fileName);
+            return false;
+        }
+
+        QDataStream stream(&traceFile);
+        stream.setVersion(QDataStream::Qt_4_8);
+
+        quint32 magic = 0;
+        quint16 version = 0;
+        stream >> magic >> version;
+        if (magic != MAGIC)
+        {
+            errorString = QObject::tr("%1 is not an input trace file.").arg(fileName);
+            return false;
+        }
+        else if (version > VERSION)
+        {
+            errorString = QObject::tr("Input trace version %1 is not supported.").arg(version);
+            return false;
+        }
+
+        quint64 currentTime = 0;
+        while (!stream.atEnd() && stream.status() == QDataStream::Ok)
+        {
+            quint8 recordType = 0;
+            stream >> recordType;
+
+            if (recordType == DeviceRecord)
+            {
+                TraceDevice device;
+                quint8 gameController = 0;
+                stream >> device.deviceKey;
+                if (version >= 2)
+                {
+                    stream >> device.joyNumber;
+                }
+                else
+                {
+                    device.joyNumber = device.deviceKey;
+                }
+
+                stream >> gameController >> device.guid >> device.name
+                       >> device.numButtons >> device.numAxes >> device.numHats;
+                device.gameController = gameController != 0;
+                devices.append(device);
+            }
+            else if (recordType <= ControllerAxisRecord)
+            {
+                TraceEvent traceEvent;
+                quint32 timeDelta = 0;
+                stream >> timeDelta >> traceEvent.deviceKey >> traceEvent.element
+                       >> traceEvent.value;
+
+                currentTime += timeDelta;
+                traceEvent.time = currentTime;
+                traceEvent.type = recordType;
+                events.append(traceEvent);
+            }
+            else
+            {
+                errorString = QObject::tr("Unknown record type %1 found in trace file.").arg(recordType);
+                return false;
+            }
+        }
+
+        if (stream.status() != QDataStream::Ok)
+        {
+            errorString = QObject::tr("Trace file %1 is truncated.").arg(fileName);
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Build the SDL event matching a trace record. Joystick and
+     *     game controller records are converted to the event type used
+     *     by the target device. Element indices are kept as is, so
+     *     callers have to translate them first when the record type does
+     *     not match the target.
+     * @param Recorded event
+     * @param SDL instance ID or SDL 1.2 index of the target device
+     * @param Whether the target device is handled as a game controller
+     * @param Event to fill
+     * @return Whether an event could be built for the target device
+     */
+    bool createSDLEvent(const TraceEvent &traceEvent, int which,
+                        bool gameController, SDL_Event *event)
+    {
+        bool result = true;
+        memset(event, 0, sizeof(SDL_Event));
+
+#ifndef USE_SDL_2
+        Q_UNUSED(gameController);
+#endif
+
+        if (traceEvent.type == JoyButtonRecord || traceEvent.type == ControllerButtonRecord)
+        {
+#ifdef USE_SDL_2
+            if (gameController)
+            {
+                event->type = traceEvent.value ? SDL_CONTROLLERBUTTONDOWN : SDL_CONTROLLERBUTTONUP;
+                event->cbutton.which = which;
+                event->cbutton.button = traceEvent.element;
+                event->cbutton.state = traceEvent.value ? SDL_PRESSED : SDL_RELEASED;
+            }
+            else
+#endif
+            {
+                event->type = traceEvent.value ? SDL_JOYBUTTONDOWN : SDL_JOYBUTTONUP;
+                event->jbutton.which = which;
+                event->jbutton.button = traceEvent.element;
+                event->jbutton.state = traceEvent.value ? SDL_PRESSED : SDL_RELEASED;
+            }
+        }
+        else if (traceEvent.type == JoyAxisRecord || traceEvent.type == ControllerAxisRecord)
+        {
+#ifdef USE_SDL_2
+            if (gameController)
+            {
+                event->type = SDL_CONTROLLERAXISMOTION;
+                event->caxis.which = which;
+                event->caxis.axis = traceEvent.element;
+                event->caxis.value = traceEvent.value;
+            }
+            else
+#endif
+            {
+                event->type = SDL_JOYAXISMOTION;
+                event->jaxis.which = which;
+                event->jaxis.axis = traceEvent.element;
+                event->jaxis.value = traceEvent.value;
+            }
+        }
+        else if (traceEvent.type == JoyHatRecord && !gameController)
+        {
+            event->type = SDL_JOYHATMOTION;
+            event->jhat.which = which;
+            event->jhat.hat = traceEvent.element;
+            event->jhat.value = traceEvent.value;
+        }
+        else
+        {
+            result = false;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef INPUTTRACE_H
+#define INPUTTRACE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+
+#ifdef USE_SDL_2
+#include <SDL2/SDL_events.h>
+#else
+#include <SDL/SDL_events.h>
+#endif
+
+/**
+ * @brief Binary format used to record raw controller input.
+ *
+ * A trace starts with a magic number and a format version followed by a
+ * stream of records. Every record starts with a record type. Device
+ * records describe a device the first time one of its events is
+ * recorded. Devices are identified by a key that is unique within the
+ * trace, so a device plugged in later never shares the key of a removed
+ * device that had the same joystick number. Event records store the time
+ * passed since the previous event in microseconds along with the device
+ * key, element and value. Version 1 traces used the joystick number as
+ * the key.
+ */
+namespace InputTrace
+{
+    const quint32 MAGIC = 0x414D5452; // "AMTR"
+    const quint16 VERSION = 2;
+
+    enum RecordType {
+        DeviceRecord = 0, JoyButtonRecord, JoyAxisRecord, JoyHatRecord,
+        ControllerButtonRecord, ControllerAxisRecord
+    };
+
+    typedef struct {
+        quint8 deviceKey;
+        // Joystick number of the device when it was recorded.
+        quint8 joyNumber;
+        bool gameController;
+        QString guid;
+        QString name;
+        quint8 numButtons;
+        quint8 numAxes;
+        quint8 numHats;
+    } TraceDevice;
+
+    typedef struct {
+        // Microseconds since the start of the trace.
+        quint64 time;
+        quint8 type;
+        quint8 deviceKey;
+        quint8 element;
+        qint16 value;
+    } TraceEvent;
+
+    bool readTraceFile(const QString &fileName, QList<TraceDevice> &devices,
+                       QList<TraceEvent> &events, QString &errorString);
+    bool createSDLEvent(const TraceEvent &traceEvent, int which,
+                        bool gameController, SDL_Event *event);
+}
+
+#endif // INPUTTRACE_H
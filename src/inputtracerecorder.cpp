@@ -0,0 +1,166 @@
+#include "inputtracerecorder.h"
+#include "logger.h"
+
+InputTraceRecorder::InputTraceRecorder(QString fileName, QObject *parent) :
+    QObject(parent),
+    traceFile(fileName)
+{
+    lastEventTime = 0;
+    recording = false;
+}
+
+InputTraceRecorder::~InputTraceRecorder()
+{
+    stop();
+}
+
+/**
+ * @brief Open the trace file and write the file header.
+ * @return Whether recording could be started
+ */
+bool InputTraceRecorder::start()
+{
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        errorString = tr("Could not open %1 for recording input.").arg(traceFile.fileName());
+        return false;
+    }
+
+    stream.setDevice(&traceFile);
+    stream.setVersion(QDataStream::Qt_4_8);
+    stream << InputTrace::MAGIC << InputTrace::VERSION;
+
+    deviceKeys.clear();
+    lastEventTime = 0;
+    recordTimer.start();
+    recording = true;
+
+    Logger::LogInfo(tr("Recording input to %1").arg(traceFile.fileName()));
+
+    return true;
+}
+
+void InputTraceRecorder::stop()
+{
+    if (recording)
+    {
+        recording = false;
+        stream.setDevice(0);
+        traceFile.close();
+    }
+}
+
+bool InputTraceRecorder::isRecording()
+{
+    return recording;
+}
+
+QString InputTraceRecorder::getErrorString()
+{
+    return errorString;
+}
+
+/**
+ * @brief Append a raw joystick or game controller event to the trace.
+ *     Other event types are ignored.
+ * @param Device that produced the event
+ * @param SDL event
+ */
+void InputTraceRecorder::recordEvent(InputDevice *device, const SDL_Event &event)
+{
+    if (!recording || !device)
+    {
+        return;
+    }
+
+    quint8 recordType = 0;
+    quint8 element = 0;
+    qint16 value = 0;
+
+    switch (event.type)
+    {
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP:
+        {
+            recordType = InputTrace::JoyButtonRecord;
+            element = event.jbutton.button;
+            value = event.type == SDL_JOYBUTTONDOWN ? 1 : 0;
+            break;
+        }
+        case SDL_JOYAXISMOTION:
+        {
+            recordType = InputTrace::JoyAxisRecord;
+            element = event.jaxis.axis;
+            value = event.jaxis.value;
+            break;
+        }
+        case SDL_JOYHATMOTION:
+        {
+            recordType = InputTrace::JoyHatRecord;
+            element = event.jhat.hat;
+            value = event.jhat.value;
+            break;
+        }
+#ifdef USE_SDL_2
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        {
+            recordType = InputTrace::ControllerButtonRecord;
+            element = event.cbutton.button;
+            value = event.type == SDL_CONTROLLERBUTTONDOWN ? 1 : 0;
+            break;
+        }
+        case SDL_CONTROLLERAXISMOTION:
+        {
+            recordType = InputTrace::ControllerAxisRecord;
+            element = event.caxis.axis;
+            value = event.caxis.value;
+            break;
+        }
+#endif
+        default:
+        {
+            return;
+        }
+    }
+
+    // Joystick numbers are reused after hotplug. Instance IDs are not.
+#ifdef USE_SDL_2
+    int deviceID = device->getSDLJoystickID();
+#else
+    int deviceID = device->getJoyNumber();
+#endif
+
+    if (!deviceKeys.contains(deviceID))
+    {
+        if (deviceKeys.size() > 0xFF)
+        {
+            // No key left for another device.
+            return;
+        }
+
+        quint8 deviceKey = static_cast<quint8>(deviceKeys.size());
+        deviceKeys.insert(deviceID, deviceKey);
+        writeDeviceRecord(device, deviceKey);
+    }
+
+    qint64 currentTime = recordTimer.nsecsElapsed() / 1000;
+    quint32 timeDelta = static_cast<quint32>(qMin(currentTime - lastEventTime,
+                                                  static_cast<qint64>(0xFFFFFFFF)));
+    lastEventTime = currentTime;
+
+    stream << recordType << timeDelta << deviceKeys.value(deviceID)
+           << element << value;
+}
+
+void InputTraceRecorder::writeDeviceRecord(InputDevice *device, quint8 deviceKey)
+{
+    stream << static_cast<quint8>(InputTrace::DeviceRecord)
+           << deviceKey
+           << static_cast<quint8>(device->getJoyNumber())
+           << static_cast<quint8>(device->isGameController() ? 1 : 0)
+           << device->getGUIDString() << device->getSDLName()
+           << static_cast<quint8>(device->getNumberRawButtons())
+           << static_cast<quint8>(device->getNumberRawAxes())
+           << static_cast<quint8>(device->getNumberRawHats());
+}
@@ -0,0 +1,45 @@
+#ifndef INPUTTRACERECORDER_H
+#define INPUTTRACERECORDER_H
+
+#include <QObject>
+#include <QFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QHash>
+
+#include "inputdevice.h"
+#include "inputtrace.h"
+
+class InputTraceRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit InputTraceRecorder(QString fileName, QObject *parent = 0);
+    ~InputTraceRecorder();
+
+    bool start();
+    void stop();
+    bool isRecording();
+    QString getErrorString();
+
+    void recordEvent(InputDevice *device, const SDL_Event &event);
+
+protected:
+    void writeDeviceRecord(InputDevice *device, quint8 deviceKey);
+
+    QFile traceFile;
+    QDataStream stream;
+    QElapsedTimer recordTimer;
+    qint64 lastEventTime;
+    // SDL instance ID, or SDL 1.2 index, to the key used in the trace.
+    QHash<int, quint8> deviceKeys;
+    QString errorString;
+    bool recording;
+
+signals:
+
+public slots:
+
+};
+
+#endif // INPUTTRACERECORDER_H
@@ -0,0 +1,404 @@
+//#include <QDebug>
+#include <QMapIterator>
+#include <QListIterator>
+#include <QHashIterator>
+#include <QStringList>
+
+#include "inputtracereplayer.h"
+#include "logger.h"
+
+#ifdef USE_SDL_2
+#include "gamecontroller/gamecontroller.h"
+#endif
+
+const double InputTraceReplayer::MAXSPEED = 1000.0;
+
+InputTraceReplayer::InputTraceReplayer(QMap<SDL_JoystickID, InputDevice*> *joysticks,
+                                       QObject *parent) :
+    QObject(parent)
+{
+    this->joysticks = joysticks;
+    nextEventIndex = 0;
+    speed = 1.0;
+
+    replayTimer.setSingleShot(true);
+    connect(&replayTimer, SIGNAL(timeout()), this, SLOT(pushDueEvents()));
+}
+
+/**
+ * @brief Read a recorded trace into memory.
+ * @param Location of the trace file
+ * @return Whether the trace was loaded
+ */
+bool InputTraceReplayer::load(QString fileName)
+{
+    traceDevices.clear();
+    traceEvents.clear();
+    errorString = QString();
+
+    return InputTrace::readTraceFile(fileName, traceDevices, traceEvents, errorString);
+}
+
+/**
+ * @brief Set the replay speed relative to the recording. A value of 2.0
+ *     replays the trace twice as fast. A value of 0 pushes every
+ *     event as fast as the event loop allows.
+ * @param Speed factor
+ */
+void InputTraceReplayer::setSpeed(double speed)
+{
+    if (speed >= 0.0 && speed <= MAXSPEED)
+    {
+        this->speed = speed;
+    }
+}
+
+double InputTraceReplayer::getSpeed()
+{
+    return speed;
+}
+
+QString InputTraceReplayer::getErrorString()
+{
+    return errorString;
+}
+
+int InputTraceReplayer::getNumberEvents()
+{
+    return traceEvents.size();
+}
+
+/**
+ * @brief Pick the connected device that will receive the events of a
+ *     recorded device. A device with the same GUID is preferred. Otherwise
+ *     the device with the recorded joystick number is used.
+ * @param Recorded device
+ * @return Matching device. NULL if no device is available.
+ */
+InputDevice* InputTraceReplayer::findMatchingDevice(const InputTrace::TraceDevice &traceDevice)
+{
+    InputDevice *result = 0;
+    InputDevice *indexMatch = 0;
+
+    QList<InputDevice*> usedDevices;
+    QHashIterator<int, ReplayTarget> usedIter(deviceMapping);
+    while (usedIter.hasNext())
+    {
+        usedDevices.append(usedIter.next().value().device);
+    }
+
+    QMapIterator<SDL_JoystickID, InputDevice*> iter(*joysticks);
+    while (iter.hasNext() && !result)
+    {
+        InputDevice *device = iter.next().value();
+        if (usedDevices.contains(device))
+        {
+            continue;
+        }
+
+        if (!traceDevice.guid.isEmpty() && device->getGUIDString() == traceDevice.guid)
+        {
+            result = device;
+        }
+        else if (!indexMatch && device->getJoyNumber() == traceDevice.joyNumber)
+        {
+            indexMatch = device;
+        }
+    }
+
+    if (!result)
+    {
+        result = indexMatch;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Read the game controller mapping SDL has for a device and keep
+ *     the plain button, axis and hat binds. Half axis, inverted and axis
+ *     to button binds are not translated.
+ * @param Device that will receive replayed events
+ */
+void InputTraceReplayer::loadMappingBinds(ReplayTarget &target)
+{
+#ifdef USE_SDL_2
+    QString mapping;
+    if (target.device->isGameController())
+    {
+        mapping = static_cast<GameController*>(target.device)->getMappingString();
+    }
+    else
+    {
+        QByteArray guidString = target.device->getGUIDString().toUtf8();
+        SDL_JoystickGUID guid = SDL_JoystickGetGUIDFromString(guidString.constData());
+        char *temp = SDL_GameControllerMappingForGUID(guid);
+        if (temp)
+        {
+            mapping = QString::fromUtf8(temp);
+            SDL_free(temp);
+            temp = 0;
+        }
+    }
+
+    // Skip the GUID and name fields.
+    QStringList binds = mapping.split(",", QString::SkipEmptyParts).mid(2);
+    QStringListIterator iter(binds);
+    while (iter.hasNext())
+    {
+        QString bind = iter.next();
+        QString element = bind.section(':', 0, 0);
+        QString source = bind.section(':', 1, 1);
+        if (source.length() < 2 || element.startsWith('+') || element.startsWith('-') ||
+            source.startsWith('+') || source.startsWith('-') || source.endsWith('~'))
+        {
+            continue;
+        }
+
+        QByteArray elementName = element.toUtf8();
+        SDL_GameControllerButton button = SDL_GameControllerGetButtonFromString(elementName.constData());
+        SDL_GameControllerAxis axis = SDL_GameControllerGetAxisFromString(elementName.constData());
+
+        bool validNumber = false;
+        if (button != SDL_CONTROLLER_BUTTON_INVALID && source.startsWith('b'))
+        {
+            int joyButton = source.mid(1).toInt(&validNumber);
+            if (validNumber)
+            {
+                target.buttonToJoyButton.insert(button, joyButton);
+            }
+        }
+        else if (button != SDL_CONTROLLER_BUTTON_INVALID && source.startsWith('h'))
+        {
+            bool validMask = false;
+            int hat = source.mid(1).section('.', 0, 0).toInt(&validNumber);
+            int mask = source.section('.', 1, 1).toInt(&validMask);
+            if (validNumber && validMask)
+            {
+                target.buttonToJoyHat.insert(button, qMakePair(hat, mask));
+            }
+        }
+        else if (axis != SDL_CONTROLLER_AXIS_INVALID && source.startsWith('a'))
+        {
+            int joyAxis = source.mid(1).toInt(&validNumber);
+            if (validNumber)
+            {
+                target.axisToJoyAxis.insert(axis, joyAxis);
+            }
+        }
+    }
+#else
+    Q_UNUSED(target);
+#endif
+}
+
+/**
+ * @brief Build the SDL events for a recorded event. Events recorded from a
+ *     game controller are translated to joystick elements when the target
+ *     is handled as a joystick, and the other way around, using the
+ *     mapping of the target. Elements without a bind are dropped.
+ * @param Device that receives the event
+ * @param Recorded event
+ * @param List that will receive the events
+ */
+void InputTraceReplayer::translateEvent(ReplayTarget &target,
+                                        const InputTrace::TraceEvent &traceEvent,
+                                        QList<SDL_Event> &events)
+{
+    SDL_Event event;
+
+#ifdef USE_SDL_2
+    int which = target.device->getSDLJoystickID();
+    bool targetController = target.device->isGameController();
+    bool recordedController = traceEvent.type == InputTrace::ControllerButtonRecord ||
+                              traceEvent.type == InputTrace::ControllerAxisRecord;
+
+    QList<InputTrace::TraceEvent> translated;
+    InputTrace::TraceEvent temp = traceEvent;
+
+    if (recordedController == targetController)
+    {
+        translated.append(temp);
+    }
+    else if (recordedController)
+    {
+        if (traceEvent.type == InputTrace::ControllerButtonRecord &&
+            target.buttonToJoyButton.contains(traceEvent.element))
+        {
+            temp.type = InputTrace::JoyButtonRecord;
+            temp.element = target.buttonToJoyButton.value(traceEvent.element);
+            translated.append(temp);
+        }
+        else if (traceEvent.type == InputTrace::ControllerButtonRecord &&
+                 target.buttonToJoyHat.contains(traceEvent.element))
+        {
+            QPair<int, int> hatBind = target.buttonToJoyHat.value(traceEvent.element);
+            int hatValue = target.hatValues.value(hatBind.first, SDL_HAT_CENTERED);
+            hatValue = traceEvent.value ? (hatValue | hatBind.second) : (hatValue & ~hatBind.second);
+            target.hatValues.insert(hatBind.first, hatValue);
+
+            temp.type = InputTrace::JoyHatRecord;
+            temp.element = hatBind.first;
+            temp.value = hatValue;
+            translated.append(temp);
+        }
+        else if (traceEvent.type == InputTrace::ControllerAxisRecord &&
+                 target.axisToJoyAxis.contains(traceEvent.element))
+        {
+            temp.type = InputTrace::JoyAxisRecord;
+            temp.element = target.axisToJoyAxis.value(traceEvent.element);
+            translated.append(temp);
+        }
+    }
+    else if (traceEvent.type == InputTrace::JoyButtonRecord &&
+             target.buttonToJoyButton.values().contains(traceEvent.element))
+    {
+        temp.type = InputTrace::ControllerButtonRecord;
+        temp.element = target.buttonToJoyButton.key(traceEvent.element);
+        translated.append(temp);
+    }
+    else if (traceEvent.type == InputTrace::JoyAxisRecord &&
+             target.axisToJoyAxis.values().contains(traceEvent.element))
+    {
+        temp.type = InputTrace::ControllerAxisRecord;
+        temp.element = target.axisToJoyAxis.key(traceEvent.element);
+        translated.append(temp);
+    }
+    else if (traceEvent.type == InputTrace::JoyHatRecord)
+    {
+        int oldValue = target.hatValues.value(traceEvent.element, SDL_HAT_CENTERED);
+        target.hatValues.insert(traceEvent.element, traceEvent.value);
+
+        // A hat change can press and release several buttons.
+        QMapIterator<int, QPair<int, int> > iter(target.buttonToJoyHat);
+        while (iter.hasNext())
+        {
+            iter.next();
+            int mask = iter.value().second;
+            if (iter.value().first == traceEvent.element &&
+                (oldValue & mask) != (traceEvent.value & mask))
+            {
+                temp.type = InputTrace::ControllerButtonRecord;
+                temp.element = iter.key();
+                temp.value = (traceEvent.value & mask) ? 1 : 0;
+                translated.append(temp);
+            }
+        }
+    }
+
+    QListIterator<InputTrace::TraceEvent> iter(translated);
+    while (iter.hasNext())
+    {
+        if (InputTrace::createSDLEvent(iter.next(), which, targetController, &event))
+        {
+            events.append(event);
+        }
+    }
+#else
+    if (InputTrace::createSDLEvent(traceEvent, target.device->getJoyNumber(), false, &event))
+    {
+        events.append(event);
+    }
+#endif
+}
+
+void InputTraceReplayer::start()
+{
+    deviceMapping.clear();
+
+    QListIterator<InputTrace::TraceDevice> iter(traceDevices);
+    while (iter.hasNext())
+    {
+        const InputTrace::TraceDevice &traceDevice = iter.next();
+        InputDevice *device = findMatchingDevice(traceDevice);
+        if (device)
+        {
+            ReplayTarget target;
+            target.device = device;
+            if (traceDevice.gameController != device->isGameController())
+            {
+                loadMappingBinds(target);
+            }
+
+            deviceMapping.insert(traceDevice.deviceKey, target);
+            Logger::LogInfo(tr("Replaying input of %1 on controller #%2")
+                            .arg(traceDevice.name).arg(device->getRealJoyNumber()));
+        }
+        else
+        {
+            Logger::LogWarning(tr("No controller available to replay input of %1")
+                               .arg(traceDevice.name));
+        }
+    }
+
+    nextEventIndex = 0;
+    replayClock.start();
+    scheduleNextEvent();
+}
+
+void InputTraceReplayer::stop()
+{
+    replayTimer.stop();
+    nextEventIndex = traceEvents.size();
+}
+
+void InputTraceReplayer::scheduleNextEvent()
+{
+    if (nextEventIndex >= traceEvents.size())
+    {
+        emit finished();
+    }
+    else if (speed <= 0.0)
+    {
+        replayTimer.start(0);
+    }
+    else
+    {
+        qint64 dueTime = static_cast<qint64>(traceEvents.at(nextEventIndex).time / speed) / 1000;
+        qint64 remaining = dueTime - replayClock.elapsed();
+        replayTimer.start(static_cast<int>(qMax(static_cast<qint64>(0), remaining)));
+    }
+}
+
+/**
+ * @brief Inject every event whose scheduled time has passed into the SDL
+ *     event queue. The events are then handled by InputDaemon like
+ *     events coming from the physical device.
+ */
+void InputTraceReplayer::pushDueEvents()
+{
+    qint64 elapsed = replayClock.nsecsElapsed() / 1000;
+    bool pushedEvent = false;
+
+    while (nextEventIndex < traceEvents.size())
+    {
+        const InputTrace::TraceEvent &traceEvent = traceEvents.at(nextEventIndex);
+        if (speed > 0.0 && static_cast<qint64>(traceEvent.time / speed) > elapsed)
+        {
+            break;
+        }
+        else if (speed <= 0.0 && pushedEvent)
+        {
+            // Let the event loop handle the previous event first.
+            break;
+        }
+
+        if (deviceMapping.contains(traceEvent.deviceKey))
+        {
+            QList<SDL_Event> events;
+            translateEvent(deviceMapping[traceEvent.deviceKey], traceEvent, events);
+
+            QListIterator<SDL_Event> iter(events);
+            while (iter.hasNext())
+            {
+                SDL_Event event = iter.next();
+                SDL_PushEvent(&event);
+                pushedEvent = true;
+            }
+        }
+
+        nextEventIndex++;
+    }
+
+    scheduleNextEvent();
+}
@@ -0,0 +1,74 @@
+#ifndef INPUTTRACEREPLAYER_H
+#define INPUTTRACEREPLAYER_H
+
+#include <QObject>
+#include <QMap>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "inputdevice.h"
+#include "inputtrace.h"
+
+class InputTraceReplayer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit InputTraceReplayer(QMap<SDL_JoystickID, InputDevice*> *joysticks,
+                                QObject *parent = 0);
+
+    bool load(QString fileName);
+    void setSpeed(double speed);
+    double getSpeed();
+    QString getErrorString();
+    int getNumberEvents();
+
+protected:
+    // Connected device that receives the events of a recorded device.
+    struct ReplayTarget {
+        InputDevice *device;
+        // Controller elements to the joystick elements they are bound to
+        // in the game controller mapping of the device. Used when a
+        // device is replayed as a game controller but was recorded as a
+        // joystick or the other way around.
+        QMap<int, int> buttonToJoyButton;
+        QMap<int, int> axisToJoyAxis;
+        // Controller button to joystick hat and hat direction.
+        QMap<int, QPair<int, int> > buttonToJoyHat;
+        // Last value of every joystick hat.
+        QHash<int, int> hatValues;
+    };
+
+    InputDevice* findMatchingDevice(const InputTrace::TraceDevice &traceDevice);
+    void loadMappingBinds(ReplayTarget &target);
+    void translateEvent(ReplayTarget &target, const InputTrace::TraceEvent &traceEvent,
+                        QList<SDL_Event> &events);
+    void scheduleNextEvent();
+
+    QMap<SDL_JoystickID, InputDevice*> *joysticks;
+    QList<InputTrace::TraceDevice> traceDevices;
+    QList<InputTrace::TraceEvent> traceEvents;
+    // Trace device key to the device receiving its events.
+    QHash<int, ReplayTarget> deviceMapping;
+    QTimer replayTimer;
+    QElapsedTimer replayClock;
+    int nextEventIndex;
+    double speed;
+    QString errorString;
+
+    static const double MAXSPEED;
+
+signals:
+    void finished();
+
+public slots:
+    void start();
+    void stop();
+
+private slots:
+    void pushDueEvents();
+};
+
+#endif // INPUTTRACEREPLAYER_H
@@ -584,6 +584,16 @@ int JoyAxis::getCurrentThrottledDeadValue()
     return currentThrottledDeadValue;
 }
 
+/**
+ * @brief Check if the axis is resting at its dead value with no active
+ *     axis buttons.
+ * @return Axis is neutral
+ */
+bool JoyAxis::isNeutral()
+{
+    return !isActive && currentRawValue == currentThrottledDeadValue;
+}
+
 double JoyAxis::getDistanceFromDeadZone()
 {
     return getDistanceFromDeadZone(currentThrottledValue);
@@ -52,6 +52,7 @@ public:
     //int getCurrentThrottledMin();
     //int getCurrentThrottledMax();
     int getCurrentThrottledDeadValue();
+    bool isNeutral();
     int getCurrentlyAssignedSet();
     JoyAxisButton* getAxisButtonByValue(int value);
 
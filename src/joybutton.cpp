@@ -8,6 +8,7 @@
 #include "vdpad.h"
 #include "event.h"
 #include "logger.h"
+#include "mousemotionthread.h"
 
 #ifdef Q_OS_WIN
   #include "eventhandlerfactory.h"
@@ -47,10 +48,12 @@ const double JoyButton::MAXIMUMEASINGDURATION = 5.0;
 
 const int JoyButton::DEFAULTMOUSEHISTORYSIZE = 10;
 const double JoyButton::DEFAULTWEIGHTMODIFIER = 0.2;
-const int JoyButton::MAXIMUMMOUSEHISTORYSIZE = 100;
+const int JoyButton::MAXIMUMMOUSEHISTORYSIZE = MouseHistoryBuffer::MAXSIZE;
 const double JoyButton::MAXIMUMWEIGHTMODIFIER = 1.0;
 const int JoyButton::MAXIMUMMOUSEREFRESHRATE = 16;
 const int JoyButton::IDLEMOUSEREFRESHRATE = 100;
+const int JoyButton::CURSORSPEEDRESERVE = 32;
+const int JoyButton::MAXIMUMMOUSECURVEPOINTS = 16;
 const double JoyButton::DEFAULTEXTRACCELVALUE = 2.0;
 const double JoyButton::DEFAULTMINACCELTHRESHOLD = 10.0;
 const double JoyButton::DEFAULTMAXACCELTHRESHOLD = 100.0;
@@ -65,9 +68,11 @@ JoyButtonSlot* JoyButton::lastActiveKey = 0;
 // Keep track of active Mouse Speed Mod slots.
 QList<JoyButtonSlot*> JoyButton::mouseSpeedModList;
 
-// Lists used for cursor mode calculations.
-QList<JoyButton::mouseCursorInfo> JoyButton::cursorXSpeeds;
-QList<JoyButton::mouseCursorInfo> JoyButton::cursorYSpeeds;
+// Arrays used for cursor mode calculations. Entries at the same index
+// belong to the same queued cursor event.
+QVector<JoyButtonSlot*> JoyButton::cursorSpeedSlots;
+QVector<double> JoyButton::cursorXSpeeds;
+QVector<double> JoyButton::cursorYSpeeds;
 
 // Lists used for spring mode calculations.
 QList<PadderCommon::springModeInfo> JoyButton::springXSpeeds;
@@ -75,6 +80,8 @@ QList<PadderCommon::springModeInfo> JoyButton::springYSpeeds;
 
 // Keeps timestamp of last mouse event.
 QTime JoyButton::lastMouseTime;
+// Measures the time between cursor mode mouse events.
+QElapsedTimer JoyButton::cursorTickTime;
 
 // Helper object to have a single mouse event for all JoyButton
 // instances.
@@ -82,9 +89,10 @@ JoyButtonMouseHelper JoyButton::mouseHelper;
 
 QTimer JoyButton::staticMouseEventTimer;
 QList<JoyButton*> JoyButton::pendingMouseButtons;
+QHash<int, MouseCurveTable> JoyButton::presetMouseCurveTables;
 
-QList<double> JoyButton::mouseHistoryX;
-QList<double> JoyButton::mouseHistoryY;
+MouseHistoryBuffer JoyButton::mouseHistoryX;
+MouseHistoryBuffer JoyButton::mouseHistoryY;
 
 double JoyButton::cursorRemainderX = 0.0;
 double JoyButton::cursorRemainderY = 0.0;
@@ -93,6 +101,7 @@ double JoyButton::weightModifier = 0;
 int JoyButton::mouseHistorySize = 1;
 
 int JoyButton::mouseRefreshRate = 5;
+MouseMotionThread* JoyButton::mouseMotionThread = 0;
 int JoyButton::springModeScreen = -1;
 
 #ifdef Q_OS_WIN
@@ -103,23 +112,31 @@ JoyButton::JoyButton(int index, int originset, SetJoystick *parentSet, QObject *
     QObject(parent)
 {
     vdpad = 0;
-    slotiter = 0;
+    slotPosition = -1;
     setChangeTimer.setSingleShot(true);
     slotSetChangeTimer.setSingleShot(true);
     this->parentSet = parentSet;
 
-    connect(&pauseWaitTimer, SIGNAL(timeout()), this, SLOT(pauseWaitEvent()));
-    connect(&keyPressTimer, SIGNAL(timeout()), this, SLOT(keyPressEvent()));
-    connect(&holdTimer, SIGNAL(timeout()), this, SLOT(holdEvent()));
-    connect(&delayTimer, SIGNAL(timeout()), this, SLOT(delayEvent()));
-    connect(&createDeskTimer, SIGNAL(timeout()), this, SLOT(waitForDeskEvent()));
-    connect(&releaseDeskTimer, SIGNAL(timeout()), this, SLOT(waitForReleaseDeskEvent()));
-    connect(&turboTimer, SIGNAL(timeout()), this, SLOT(turboEvent()));
-    connect(&mouseWheelVerticalEventTimer, SIGNAL(timeout()), this, SLOT(wheelEventVertical()));
-    connect(&mouseWheelHorizontalEventTimer, SIGNAL(timeout()), this, SLOT(wheelEventHorizontal()));
-    connect(&setChangeTimer, SIGNAL(timeout()), this, SLOT(checkForSetChange()));
+    // Button timers are driven by a shared timer wheel rather than
+    // being individual QObjects.
+    pauseWaitTimer.setReceiver(this, SLOT(pauseWaitEvent()));
+    keyPressTimer.setReceiver(this, SLOT(keyPressEvent()));
+    holdTimer.setReceiver(this, SLOT(holdEvent()));
+    delayTimer.setReceiver(this, SLOT(delayEvent()));
+    createDeskTimer.setReceiver(this, SLOT(waitForDeskEvent()));
+    releaseDeskTimer.setReceiver(this, SLOT(waitForReleaseDeskEvent()));
+    turboTimer.setReceiver(this, SLOT(turboEvent()));
+    mouseWheelVerticalEventTimer.setReceiver(this, SLOT(wheelEventVertical()));
+    mouseWheelHorizontalEventTimer.setReceiver(this, SLOT(wheelEventHorizontal()));
+    setChangeTimer.setReceiver(this, SLOT(checkForSetChange()));
     //connect(&keyRepeatTimer, SIGNAL(timeout()), this, SLOT(repeatKeysEvent()));
-    connect(&slotSetChangeTimer, SIGNAL(timeout()), this, SLOT(slotSetChange()));
+    slotSetChangeTimer.setReceiver(this, SLOT(slotSetChange()));
+
+    // Keep capacity for queued cursor events so clearing the arrays
+    // every mouse tick does not release their storage.
+    cursorSpeedSlots.reserve(CURSORSPEEDRESERVE);
+    cursorXSpeeds.reserve(CURSORSPEEDRESERVE);
+    cursorYSpeeds.reserve(CURSORSPEEDRESERVE);
 
     establishMouseTimerConnections();
 
@@ -139,6 +156,8 @@ JoyButton::~JoyButton()
 
 void JoyButton::joyEvent(bool pressed, bool ignoresets)
 {
+    InputLatencyTracer::markStage(InputLatencyTracer::StageJoyEvent);
+
     if (this->vdpad)
     {
         if (pressed != isButtonPressed)
@@ -182,6 +201,8 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
     {
         if (pressed != isDown)
         {
+            InputLatencyTracer::captureEvent(&latencyContext);
+
             if (pressed)
             {
                 //qDebug() << "PRESS STARTED: " << QTime::currentTime().toString("hh:mm:ss.zzz");
@@ -240,9 +261,9 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
                 if (isButtonPressed && activePress && !turboTimer.isActive())
                 {
                     if (cycleResetActive &&
-                        cycleResetHold.elapsed() >= cycleResetInterval && slotiter)
+                        cycleResetHold.elapsed() >= cycleResetInterval && slotPosition >= 0)
                     {
-                        slotiter->toFront();
+                        slotPosition = 0;
                         currentCycle = 0;
                         previousCycle = 0;
                     }
@@ -303,9 +324,9 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
             else if (isButtonPressed && activePress)
             {
                 if (cycleResetActive &&
-                    cycleResetHold.elapsed() >= cycleResetInterval && slotiter)
+                    cycleResetHold.elapsed() >= cycleResetInterval && slotPosition >= 0)
                 {
-                    slotiter->toFront();
+                    slotPosition = 0;
                     currentCycle = 0;
                     previousCycle = 0;
                 }
@@ -448,11 +469,7 @@ void JoyButton::reset()
     //keyRepeatTimer.stop();
     slotSetChangeTimer.stop();
 
-    if (slotiter)
-    {
-        delete slotiter;
-        slotiter = 0;
-    }
+    slotPosition = -1;
 
     releaseActiveSlots();
     //releaseDeskEvent(true);
@@ -537,7 +554,7 @@ bool JoyButton::distanceEvent()
 {
     bool released = false;
 
-    if (slotiter)
+    if (slotPosition >= 0)
     {
         bool distanceFound = containsDistanceSlots();
 
@@ -546,33 +563,31 @@ bool JoyButton::distanceEvent()
             double currentDistance = getDistanceFromDeadZone();
             double tempDistance = 0.0;
             JoyButtonSlot *previousDistanceSlot = 0;
-            QListIterator<JoyButtonSlot*> iter(assignments);
-            if (previousCycle)
-            {
-                iter.findNext(previousCycle);
-            }
+            int position = previousCycle ? slotPositionAfter(previousCycle) : 0;
+            int programSize = slotProgram.size();
 
-            while (iter.hasNext())
+            while (position < programSize)
             {
-                JoyButtonSlot *slot = iter.next();
-                int tempcode = slot->getSlotCode();
-                if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
+                const JoyButtonSlotProgram::Instruction &instruction = slotProgram.at(position);
+                position++;
+
+                if (instruction.mode == JoyButtonSlot::JoyDistance)
                 {
-                    tempDistance += tempcode / 100.0;
+                    tempDistance += instruction.code / 100.0;
 
                     if (currentDistance < tempDistance)
                     {
-                        iter.toBack();
+                        position = programSize;
                     }
                     else
                     {
-                        previousDistanceSlot = slot;
+                        previousDistanceSlot = instruction.slot;
                     }
                 }
-                else if (slot->getSlotMode() == JoyButtonSlot::JoyCycle)
+                else if (instruction.mode == JoyButtonSlot::JoyCycle)
                 {
                     tempDistance = 0.0;
-                    iter.toBack();
+                    position = programSize;
                 }
             }
 
@@ -592,11 +607,7 @@ bool JoyButton::distanceEvent()
                     currentPause = currentHold = 0;
                     //quitEvent = true;
 
-                    slotiter->toFront();
-                    if (previousCycle)
-                    {
-                        slotiter->findNext(previousCycle);
-                    }
+                    slotPosition = previousCycle ? slotPositionAfter(previousCycle) : 0;
 
                     this->currentDistance = 0;
                     released = true;
@@ -619,13 +630,8 @@ bool JoyButton::distanceEvent()
                     currentPause = currentHold = 0;
                     //quitEvent = true;
 
-                    slotiter->toFront();
-                    if (previousCycle)
-                    {
-                        slotiter->findNext(previousCycle);
-                    }
-
-                    slotiter->findNext(previousDistanceSlot);
+                    slotPosition = previousCycle ? slotPositionAfter(previousCycle) : 0;
+                    slotPosition = slotPositionAfter(previousDistanceSlot, slotPosition);
 
                     this->currentDistance = previousDistanceSlot;
                     released = true;
@@ -641,12 +647,12 @@ void JoyButton::createDeskEvent()
 {
     quitEvent = false;
 
-    if (!slotiter)
+    if (slotPosition < 0)
     {
-        slotiter = new QListIterator<JoyButtonSlot*> (assignments);
+        slotPosition = 0;
         distanceEvent();
     }
-    else if (!slotiter->hasPrevious())
+    else if (slotPosition == 0)
     {
         distanceEvent();
     }
@@ -670,18 +676,25 @@ void JoyButton::createDeskEvent()
 
 void JoyButton::activateSlots()
 {
-    if (slotiter)
+    InputLatencyTracer::ContextScope latencyScope(&latencyContext);
+    InputLatencyTracer::markStage(InputLatencyTracer::StageActivateSlots);
+
+    if (slotPosition >= 0)
     {
         bool exit = false;
         //bool delaySequence = checkForDelaySequence();
         bool delaySequence = false;
         bool changeRepeatState = false;
 
-        while (slotiter->hasNext() && !exit)
+        while (slotPosition < slotProgram.size() && !exit)
         {
-            JoyButtonSlot *slot = slotiter->next();
-            int tempcode = slot->getSlotCode();
-            JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
+            // Copy the instruction fields. Some actions can cause the
+            // program to be recompiled.
+            const JoyButtonSlotProgram::Instruction &instruction = slotProgram.at(slotPosition);
+            JoyButtonSlot *slot = instruction.slot;
+            int tempcode = instruction.code;
+            JoyButtonSlot::JoySlotInputAction mode = instruction.mode;
+            slotPosition++;
 
             if (mode == JoyButtonSlot::JoyKeyboard)
             {
@@ -761,9 +774,9 @@ void JoyButton::activateSlots()
             {
                 if (!activeSlots.isEmpty())
                 {
-                    if (slotiter->hasPrevious())
+                    if (slotPosition > 0)
                     {
-                        slotiter->previous();
+                        slotPosition--;
                     }
                     delaySequence = true;
                     exit = true;
@@ -819,9 +832,9 @@ void JoyButton::activateSlots()
                 }
                 else if (currentRelease && !activeSlots.isEmpty())
                 {
-                    if (slotiter->hasPrevious())
+                    if (slotPosition > 0)
                     {
-                        slotiter->previous();
+                        slotPosition--;
                     }
                     delaySequence = true;
                     exit = true;
@@ -843,9 +856,9 @@ void JoyButton::activateSlots()
                 }
                 else
                 {
-                    if (slotiter->hasPrevious())
+                    if (slotPosition > 0)
                     {
-                        slotiter->previous();
+                        slotPosition--;
                     }
                     delaySequence = true;
                     exit = true;
@@ -854,7 +867,7 @@ void JoyButton::activateSlots()
             else if (mode == JoyButtonSlot::JoyLoadProfile)
             {
                 releaseActiveSlots();
-                slotiter->toBack();
+                slotPosition = slotProgram.size();
                 exit = true;
 
                 QString location = slot->getTextData();
@@ -990,72 +1003,31 @@ void JoyButton::mouseEvent()
                     double sumDist = buttonslot->getMouseDistance();
                     JoyMouseCurve currentCurve = getMouseCurve();
 
+                    // Curve values for the current distance come from the
+                    // table built when the curve settings changed. Only the
+                    // time dependent parts are evaluated here. A power curve
+                    // bends too sharply to interpolate near the dead zone with
+                    // a high sensitivity and near the end of the range with a
+                    // sensitivity below 1. The first interval is calculated
+                    // directly in the first case and the whole curve in the
+                    // second.
+                    if (currentCurve == PowerCurve &&
+                        (sensitivity < 1.0 ||
+                         difference < MouseCurveTable::getDistanceForIndex(1)))
+                    {
+                        difference = calculateMouseCurveValue(currentCurve, difference,
+                                                              sensitivity, mouseCurvePoints);
+                    }
+                    else
+                    {
+                        difference = mouseCurveTable.lookup(difference);
+                    }
+
                     switch (currentCurve)
                     {
-                        case LinearCurve:
-                        {
-                            break;
-                        }
-                        case QuadraticCurve:
-                        {
-                            difference = difference * difference;
-                            break;
-                        }
-                        case CubicCurve:
-                        {
-                            difference = difference * difference * difference;
-                            break;
-                        }
                         case QuadraticExtremeCurve:
                         {
-                            double temp = difference;
-                            difference = difference * difference;
-                            difference = (temp >= 0.95) ? (difference * 1.5) : difference;
-                            break;
-                        }
-                        case PowerCurve:
-                        {
-                            double tempsensitive = qMin(qMax(sensitivity, 1.0e-3), 1.0e+3);
-                            double temp = qMin(qMax(pow(difference, 1.0 / tempsensitive), 0.0), 1.0);
-                            difference = temp;
-                            break;
-                        }
-                        case EnhancedPrecisionCurve:
-                        {
-                            // Perform different forms of acceleration depending on
-                            // the range of the element from its assigned dead zone.
-                            // Useful for more precise controls with an axis.
-                            double temp = difference;
-                            if (temp <= 0.4)
-                            {
-                                // Perform Quadratic acceleration.
-                                //difference = difference * difference;
-
-                                // Low slope value for really slow acceleration
-                                difference = difference * 0.405; // Experimental
-                            }
-                            else if (temp <= 0.8)
-                            {
-                                // Perform Linear accleration with an appropriate
-                                // offset.
-                                //difference = difference - 0.24;
-                                difference = difference - 0.238; // Experimental
-                            }
-                            else if (temp > 0.8)
-                            {
-                                // Perform mouse acceleration. Make up the difference
-                                // due to the previous two segments. Maxes out at 1.0.
-                                //difference = (difference * 2.2) - 1.2;
-                                difference = (difference * 2.19) - 1.19; // Experimental
-                            }
-
-                            //if (temp - lastMouseDistance > 0)
-                            //{
-                                //qDebug() << "TEMP: " << temp;
-                                //qDebug() << "LAST: " << lastMouseDistance;
-                                //qDebug() << "";
-                            //}
-
+                            difference = (initialDifference >= 0.95) ? (difference * 1.5) : difference;
                             break;
                         }
                         case EasingQuadraticCurve:
@@ -1064,28 +1036,11 @@ void JoyButton::mouseEvent()
                             // Perform different forms of acceleration depending on
                             // the range of the element from its assigned dead zone.
                             // Useful for more precise controls with an axis.
-                            double temp = difference;
-                            if (temp <= 0.4)
+                            // The low and middle ranges use the Enhanced
+                            // Precision values from the table.
+                            double temp = initialDifference;
+                            if (temp <= 0.8)
                             {
-                                // Perform Quadratic acceleration.
-                                //difference = difference * difference;
-
-                                // Low slope value for really slow acceleration
-                                difference = difference * 0.405; // Experimental
-
-                                if (buttonslot->isEasingActive())
-                                {
-                                    buttonslot->setEasingStatus(false);
-                                    buttonslot->getEasingTime()->restart();
-                                }
-                            }
-                            else if (temp <= 0.8)
-                            {
-                                // Perform Linear accleration with an appropriate
-                                // offset.
-                                //difference = difference - 0.24;
-                                difference = difference - 0.238; // Experimental
-
                                 if (buttonslot->isEasingActive())
                                 {
                                     buttonslot->setEasingStatus(false);
@@ -1130,7 +1085,7 @@ void JoyButton::mouseEvent()
                                 }
 
                                 // Allow gradient control on the high end of an axis.
-                                difference = elapsedDiff * difference;
+                                difference = elapsedDiff * temp;
 
                                 //difference = difference * 7.2 - 5.2; // Range 0.56 - 2.0. Non-gradient version.
                                 //difference = difference * 4.7 - 3.2; // Range 0.56 - 1.5. Non-gradient version.
@@ -1138,11 +1093,10 @@ void JoyButton::mouseEvent()
                             }
                             break;
                         }
-                        /*default:
+                        default:
                         {
                             break;
                         }
-                        */
                     }
 
                     double distance = 0;
@@ -1293,15 +1247,9 @@ void JoyButton::mouseEvent()
                         mouse2 = -distance;
                     }
 
-                    mouseCursorInfo infoX;
-                    infoX.code = mouse1;
-                    infoX.slot = buttonslot;
-                    cursorXSpeeds.append(infoX);
-
-                    mouseCursorInfo infoY;
-                    infoY.code = mouse2;
-                    infoY.slot = buttonslot;
-                    cursorYSpeeds.append(infoY);
+                    cursorSpeedSlots.append(buttonslot);
+                    cursorXSpeeds.append(mouse1);
+                    cursorYSpeeds.append(mouse2);
                     sumDist = 0;
 
                     buttonslot->setDistance(sumDist);
@@ -1641,6 +1589,20 @@ void JoyButton::writeConfig(QXmlStreamWriter *xml)
             {
                 xml->writeTextElement("mouseacceleration", "easing-cubic");
             }
+            else if (mouseCurve == CustomCurve)
+            {
+                xml->writeTextElement("mouseacceleration", "custom");
+
+                QStringList pointList;
+                QListIterator<QPointF> iter(mouseCurvePoints);
+                while (iter.hasNext())
+                {
+                    QPointF point = iter.next();
+                    pointList.append(QString("%1,%2").arg(point.x()).arg(point.y()));
+                }
+
+                xml->writeTextElement("mousecurvepoints", pointList.join(" "));
+            }
         }
 
         if (wheelSpeedX != DEFAULTWHEELX)
@@ -1950,6 +1912,35 @@ bool JoyButton::readButtonConfig(QXmlStreamReader *xml)
         {
             setMouseCurve(EasingCubicCurve);
         }
+        else if (temptext == "custom")
+        {
+            setMouseCurve(CustomCurve);
+        }
+    }
+    else if (xml->name() == "mousecurvepoints" && xml->isStartElement())
+    {
+        found = true;
+        QString temptext = xml->readElementText();
+        QStringList pointList = temptext.split(" ", QString::SkipEmptyParts);
+        QList<QPointF> tempPoints;
+        QStringListIterator iter(pointList);
+        while (iter.hasNext())
+        {
+            QStringList coordinates = iter.next().split(",");
+            if (coordinates.size() == 2)
+            {
+                bool validX = false;
+                bool validY = false;
+                double tempX = coordinates.at(0).toDouble(&validX);
+                double tempY = coordinates.at(1).toDouble(&validY);
+                if (validX && validY)
+                {
+                    tempPoints.append(QPointF(tempX, tempY));
+                }
+            }
+        }
+
+        setMouseCurvePoints(tempPoints);
     }
     else if (xml->name() == "mousespringwidth" && xml->isStartElement())
     {
@@ -2432,6 +2423,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     if (slotInserted)
     {
         checkTurboCondition(slot);
+        compileSlotProgram();
         emit slotsChanged();
     }
     else
@@ -2471,6 +2463,7 @@ bool JoyButton::setAssignedSlot(int code, unsigned int alias, JoyButtonSlot::Joy
     if (slotInserted)
     {
         checkTurboCondition(slot);
+        compileSlotProgram();
         emit slotsChanged();
     }
     else
@@ -2531,6 +2524,7 @@ bool JoyButton::setAssignedSlot(int code, unsigned int alias, int index, JoyButt
         }
 
         checkTurboCondition(slot);
+        compileSlotProgram();
         emit slotsChanged();
     }
     else
@@ -2592,6 +2586,7 @@ bool JoyButton::insertAssignedSlot(int code, unsigned int alias, int index, JoyB
         }
 
         checkTurboCondition(slot);
+        compileSlotProgram();
         emit slotsChanged();
     }
     else
@@ -2634,6 +2629,7 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot)
     {
         checkTurboCondition(newSlot);
         assignments.append(newSlot);
+        compileSlotProgram();
 
         emit slotsChanged();
     }
@@ -2689,6 +2685,7 @@ bool JoyButton::setAssignedSlot(JoyButtonSlot *otherSlot, int index)
             assignments.append(newslot);
         }
 
+        compileSlotProgram();
         emit slotsChanged();
     }
     else
@@ -2793,6 +2790,22 @@ bool JoyButton::getButtonState()
     return isButtonPressed;
 }
 
+/**
+ * @brief Check if the button is fully released. A release event for a
+ *     neutral button does not change anything.
+ * @return Button is released
+ */
+bool JoyButton::isNeutral()
+{
+    bool result = !isDown;
+    if (vdpad || ignoreEvents)
+    {
+        result = !isButtonPressed;
+    }
+
+    return result;
+}
+
 int JoyButton::getOriginSet()
 {
     return originset;
@@ -2804,9 +2817,9 @@ void JoyButton::pauseWaitEvent()
     {
         if (!isButtonPressedQueue.isEmpty() && createDeskTimer.isActive())
         {
-            if (slotiter)
+            if (slotPosition >= 0)
             {
-                slotiter->toBack();
+                slotPosition = slotProgram.size();
 
                 bool lastIgnoreSetState = ignoreSetQueue.last();
                 bool lastIsButtonPressed = isButtonPressedQueue.last();
@@ -2822,11 +2835,7 @@ void JoyButton::pauseWaitEvent()
                 releaseDeskTimer.stop();
                 pauseWaitTimer.stop();
 
-                slotiter->toFront();
-                if (previousCycle)
-                {
-                    slotiter->findNext(previousCycle);
-                }
+                slotPosition = previousCycle ? slotPositionAfter(previousCycle) : 0;
                 quitEvent = true;
                 keyPressHold.restart();
                 //waitForDeskEvent();
@@ -3053,24 +3062,7 @@ void JoyButton::waitForReleaseDeskEvent()
 
 bool JoyButton::containsSequence()
 {
-    bool result = false;
-
-    QListIterator<JoyButtonSlot*> tempiter(assignments);
-    while (tempiter.hasNext())
-    {
-        JoyButtonSlot *slot = tempiter.next();
-        JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
-        if (mode == JoyButtonSlot::JoyPause ||
-            mode == JoyButtonSlot::JoyHold ||
-            mode == JoyButtonSlot::JoyDistance
-           )
-        {
-            result = true;
-            tempiter.toBack();
-        }
-    }
-
-    return result;
+    return slotProgram.hasSequenceSlots();
 }
 
 void JoyButton::holdEvent()
@@ -3107,7 +3099,7 @@ void JoyButton::holdEvent()
             currentHold = 0;
             holdTimer.stop();
 
-            if (slotiter)
+            if (slotPosition >= 0)
             {
                 findHoldEventEnd();
                 createDeskEvent();
@@ -3258,41 +3250,35 @@ void JoyButton::releaseDeskEvent(bool skipsetchange)
         startingAccelerationDistance = 0.0;
         updateStartingMouseDistance = true;
 
-        if (slotiter && !slotiter->hasNext())
+        bool programEnd = slotPosition >= slotProgram.size();
+        if (slotPosition >= 0 && programEnd)
         {
             // At the end of the list of assignments.
             currentCycle = 0;
             previousCycle = 0;
-            slotiter->toFront();
+            slotPosition = 0;
         }
-        else if (slotiter && slotiter->hasNext() && currentCycle)
+        else if (slotPosition >= 0 && !programEnd && currentCycle)
         {
             // Cycle at the end of a segment.
-            slotiter->toFront();
-            slotiter->findNext(currentCycle);
+            slotPosition = slotPositionAfter(currentCycle);
         }
-        else if (slotiter && slotiter->hasPrevious() && slotiter->hasNext() && !currentCycle)
+        else if (slotPosition > 0 && !programEnd && !currentCycle)
         {
             // Check if there is a cycle action slot after
             // current slot. Useful after dealing with pause
             // actions.
-            JoyButtonSlot *tempslot = 0;
-            bool exit = false;
-            while (slotiter->hasNext() && !exit)
+            int cyclePosition = slotProgram.nextCycle(slotPosition);
+            if (cyclePosition < slotProgram.size())
             {
-                tempslot = slotiter->next();
-                if (tempslot->getSlotMode() == JoyButtonSlot::JoyCycle)
-                {
-                    currentCycle = tempslot;
-                    exit = true;
-                }
+                currentCycle = slotProgram.at(cyclePosition).slot;
+                slotPosition = cyclePosition + 1;
             }
-
-            // Didn't find any cycle. Move iterator
+            // Didn't find any cycle. Move position
             // to the front.
-            if (!currentCycle)
+            else
             {
-                slotiter->toFront();
+                slotPosition = 0;
                 previousCycle = 0;
             }
         }
@@ -3302,11 +3288,12 @@ void JoyButton::releaseDeskEvent(bool skipsetchange)
             previousCycle = currentCycle;
             currentCycle = 0;
         }
-        else if (slotiter && slotiter->hasNext() && containsReleaseSlots())
+        else if (slotPosition >= 0 && slotPosition < slotProgram.size() &&
+                 containsReleaseSlots())
         {
             currentCycle = 0;
             previousCycle = 0;
-            slotiter->toFront();
+            slotPosition = 0;
         }
 
         this->currentDistance = 0;
@@ -3381,19 +3368,7 @@ double JoyButton::getTotalSlotDistance(JoyButtonSlot *slot)
 
 bool JoyButton::containsDistanceSlots()
 {
-    bool result = false;
-    QListIterator<JoyButtonSlot*> iter(assignments);
-    while (iter.hasNext())
-    {
-        JoyButtonSlot *slot = iter.next();
-        if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
+    return slotProgram.hasDistanceSlots();
 }
 
 void JoyButton::clearAssignedSlots(bool signalEmit)
@@ -3410,6 +3385,7 @@ void JoyButton::clearAssignedSlots(bool signalEmit)
     }
 
     assignments.clear();
+    compileSlotProgram();
     if (signalEmit)
     {
         emit slotsChanged();
@@ -3427,6 +3403,7 @@ void JoyButton::removeAssignedSlot(int index)
             slot = 0;
         }
 
+        compileSlotProgram();
         emit slotsChanged();
     }
 }
@@ -3448,11 +3425,7 @@ void JoyButton::clearSlotsEventReset(bool clearSignalEmit)
 #endif
     //keyRepeatTimer.stop();
 
-    if (slotiter)
-    {
-        delete slotiter;
-        slotiter = 0;
-    }
+    slotPosition = -1;
 
     releaseActiveSlots();
     //releaseDeskEvent(true);
@@ -3499,11 +3472,7 @@ void JoyButton::eventReset()
 #endif
     //keyRepeatTimer.stop();
 
-    if (slotiter)
-    {
-        delete slotiter;
-        slotiter = 0;
-    }
+    slotPosition = -1;
 
     isButtonPressedQueue.clear();
     ignoreSetQueue.clear();
@@ -3601,49 +3570,24 @@ void JoyButton::releaseActiveSlots()
                 JoyMouseMovementMode mousemode = getMouseMode();
                 if (mousemode == MouseCursor)
                 {
-                    QListIterator<mouseCursorInfo> iterX(cursorXSpeeds);
-                    unsigned int i = cursorXSpeeds.length();
-
-                    QList<int> indexesToRemove;
-                    while (iterX.hasNext())
-                    {
-                        mouseCursorInfo info = iterX.next();
-                        if (info.slot == slot)
-                        {
-                            indexesToRemove.append(i);
-                        }
-
-                        i++;
-                    }
-
-                    QListIterator<int> removeXIter(indexesToRemove);
-                    while (removeXIter.hasPrevious())
-                    {
-                        int index = removeXIter.previous();
-                        cursorXSpeeds.removeAt(index);
-                    }
-                    indexesToRemove.clear();
-
-                    i = cursorYSpeeds.length();
-
-                    QListIterator<mouseCursorInfo> iterY(cursorYSpeeds);
-                    while (iterY.hasNext())
+                    // Compact the queued cursor events in place and
+                    // drop the events that belong to this slot.
+                    int queueLength = cursorSpeedSlots.size();
+                    int remaining = 0;
+                    for (int i=0; i < queueLength; i++)
                     {
-                        mouseCursorInfo info = iterY.next();
-                        if (info.slot == slot)
+                        if (cursorSpeedSlots.at(i) != slot)
                         {
-                            indexesToRemove.append(i);
+                            cursorSpeedSlots[remaining] = cursorSpeedSlots.at(i);
+                            cursorXSpeeds[remaining] = cursorXSpeeds.at(i);
+                            cursorYSpeeds[remaining] = cursorYSpeeds.at(i);
+                            remaining++;
                         }
-                        i++;
                     }
 
-                    QListIterator<int> removeYIter(indexesToRemove);
-                    while (removeYIter.hasPrevious())
-                    {
-                        int index = removeYIter.previous();
-                        cursorYSpeeds.removeAt(index);
-                    }
-                    indexesToRemove.clear();
+                    cursorSpeedSlots.resize(remaining);
+                    cursorXSpeeds.resize(remaining);
+                    cursorYSpeeds.resize(remaining);
 
                     slot->getEasingTime()->restart();
                     slot->setEasingStatus(false);
@@ -3725,22 +3669,11 @@ void JoyButton::releaseActiveSlots()
         // Check if mouse event timer should be stopped.
         // Only need to check one list from cursor speeds and spring speeds
         // since the correspond Y lists will be the same size.
-        if (pendingMouseButtons.length() == 0 && cursorXSpeeds.length() == 0 &&
+        if (pendingMouseButtons.length() == 0 && cursorSpeedSlots.size() == 0 &&
             springXSpeeds.length() == 0)
         {
             lastMouseTime.restart();
-            if (staticMouseEventTimer.interval() != IDLEMOUSEREFRESHRATE)
-            {
-                staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
-                mouseHistoryX.clear();
-                mouseHistoryY.clear();
-
-                for (int i=0; i < mouseHistorySize; i++)
-                {
-                    mouseHistoryX.append(0);
-                    mouseHistoryY.append(0);
-                }
-            }
+            stopIdleMouseEventTimer();
 
             /*staticMouseEventTimer.stop();
             mouseHistoryX.clear();
@@ -3756,6 +3689,11 @@ void JoyButton::releaseActiveSlots()
             */
             cursorRemainderX = 0;
             cursorRemainderY = 0;
+
+            if (mouseMotionThread)
+            {
+                mouseMotionThread->clearVelocity();
+            }
         }
 
 #ifdef Q_OS_WIN
@@ -3788,19 +3726,7 @@ void JoyButton::releaseActiveSlots()
 
 bool JoyButton::containsReleaseSlots()
 {
-    bool result = false;
-    QListIterator<JoyButtonSlot*> iter(assignments);
-    while (iter.hasNext())
-    {
-        JoyButtonSlot *slot = iter.next();
-        if (slot->getSlotMode() == JoyButtonSlot::JoyRelease)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
+    return slotProgram.hasReleaseSlots();
 }
 
 void JoyButton::releaseSlotEvent()
@@ -3812,40 +3738,36 @@ void JoyButton::releaseSlotEvent()
 
     if (containsReleaseSlots())
     {
-        QListIterator<JoyButtonSlot*> iter(assignments);
-        if (previousCycle)
-        {
-            iter.findNext(previousCycle);
-        }
+        int position = previousCycle ? slotPositionAfter(previousCycle) : 0;
+        int programSize = slotProgram.size();
 
-        while (iter.hasNext())
+        while (position < programSize)
         {
-            JoyButtonSlot *currentSlot = iter.next();
-            int tempcode = currentSlot->getSlotCode();
-            JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
-            if (mode == JoyButtonSlot::JoyRelease)
+            const JoyButtonSlotProgram::Instruction &instruction = slotProgram.at(position);
+            position++;
+
+            if (instruction.mode == JoyButtonSlot::JoyRelease)
             {
-                tempElapsed += tempcode;
+                tempElapsed += instruction.code;
                 if (tempElapsed <= timeElapsed)
                 {
-                    temp = currentSlot;
+                    temp = instruction.slot;
                 }
                 else if (tempElapsed > timeElapsed)
                 {
-                    iter.toBack();
+                    position = programSize;
                 }
             }
-            else if (mode == JoyButtonSlot::JoyCycle)
+            else if (instruction.mode == JoyButtonSlot::JoyCycle)
             {
                 tempElapsed = 0;
-                iter.toBack();
+                position = programSize;
             }
         }
 
-        if (temp && slotiter)
+        if (temp && slotPosition >= 0)
         {
-            slotiter->toFront();
-            slotiter->findNext(temp);
+            slotPosition = slotPositionAfter(temp);
             currentRelease = temp;
 
             activateSlots();
@@ -3869,32 +3791,13 @@ void JoyButton::releaseSlotEvent()
 
 
 
+/**
+ * @brief Skip to the end of the current segment. The position is placed
+ *     before the next release, hold or cycle slot.
+ */
 void JoyButton::findReleaseEventEnd()
 {
-    bool found = false;
-    while (!found && slotiter->hasNext())
-    {
-        JoyButtonSlot *currentSlot = slotiter->next();
-        JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
-
-        if (mode == JoyButtonSlot::JoyRelease)
-        {
-            found = true;
-        }
-        else if (mode == JoyButtonSlot::JoyCycle)
-        {
-            found = true;
-        }
-        else if (mode == JoyButtonSlot::JoyHold)
-        {
-            found = true;
-        }
-    }
-
-    if (found && slotiter->hasPrevious())
-    {
-        slotiter->previous();
-    }
+    slotPosition = slotProgram.segmentEnd(slotPosition);
 }
 
 void JoyButton::findReleaseEventIterEnd(QListIterator<JoyButtonSlot*> *tempiter)
@@ -3930,30 +3833,39 @@ void JoyButton::findReleaseEventIterEnd(QListIterator<JoyButtonSlot*> *tempiter)
 
 void JoyButton::findHoldEventEnd()
 {
-    bool found = false;
+    slotPosition = slotProgram.segmentEnd(slotPosition);
+}
 
-    while (!found && slotiter->hasNext())
+/**
+ * @brief Find the program position that follows a slot. Mirrors calling
+ *     findNext on an iterator over the assignments.
+ * @param Slot to find
+ * @param Position to start searching from
+ * @return Position after the slot. End of the program if the slot was
+ *     not found.
+ */
+int JoyButton::slotPositionAfter(JoyButtonSlot *slot, int from)
+{
+    int result = slotProgram.size();
+    int index = slotProgram.indexOf(slot, from);
+    if (index >= 0)
     {
-        JoyButtonSlot *currentSlot = slotiter->next();
-        JoyButtonSlot::JoySlotInputAction mode = currentSlot->getSlotMode();
-
-        if (mode == JoyButtonSlot::JoyRelease)
-        {
-            found = true;
-        }
-        else if (mode == JoyButtonSlot::JoyCycle)
-        {
-            found = true;
-        }
-        else if (mode == JoyButtonSlot::JoyHold)
-        {
-            found = true;
-        }
+        result = index + 1;
     }
 
-    if (found && slotiter->hasPrevious())
+    return result;
+}
+
+/**
+ * @brief Rebuild the slot program after the assignments have changed.
+ *     An active sequence keeps its position when it is still valid.
+ */
+void JoyButton::compileSlotProgram()
+{
+    slotProgram.compile(assignments);
+    if (slotPosition > slotProgram.size())
     {
-        slotiter->previous();
+        slotPosition = slotProgram.size();
     }
 }
 
@@ -4044,6 +3956,7 @@ JoyButton::JoyMouseMovementMode JoyButton::getMouseMode()
 void JoyButton::setMouseCurve(JoyMouseCurve selectedCurve)
 {
     mouseCurve = selectedCurve;
+    updateMouseCurveTable();
     emit propertyUpdated();
 }
 
@@ -4052,6 +3965,44 @@ JoyButton::JoyMouseCurve JoyButton::getMouseCurve()
     return mouseCurve;
 }
 
+/**
+ * @brief Set the points used by the custom mouse curve. Points are sorted by
+ *     distance and values outside of the range 0.0 - 1.0 are clamped.
+ * @param Points where x is the distance from the dead zone and y is the
+ *     fraction of the mouse speed to use.
+ */
+void JoyButton::setMouseCurvePoints(QList<QPointF> points)
+{
+    QList<QPointF> tempPoints;
+    QListIterator<QPointF> iter(points);
+    while (iter.hasNext() && tempPoints.size() < MAXIMUMMOUSECURVEPOINTS)
+    {
+        QPointF point = iter.next();
+        point.setX(qBound(0.0, point.x(), 1.0));
+        point.setY(qBound(0.0, point.y(), 1.0));
+
+        int index = 0;
+        while (index < tempPoints.size() && tempPoints.at(index).x() <= point.x())
+        {
+            index++;
+        }
+
+        tempPoints.insert(index, point);
+    }
+
+    if (tempPoints != mouseCurvePoints)
+    {
+        mouseCurvePoints = tempPoints;
+        updateMouseCurveTable();
+        emit propertyUpdated();
+    }
+}
+
+QList<QPointF> JoyButton::getMouseCurvePoints()
+{
+    return mouseCurvePoints;
+}
+
 void JoyButton::setSpringWidth(int value)
 {
     if (value >= 0)
@@ -4085,6 +4036,11 @@ void JoyButton::setSensitivity(double value)
     if (value >= 0.001 && value <= 1000)
     {
         sensitivity = value;
+        if (mouseCurve == PowerCurve)
+        {
+            updateMouseCurveTable();
+        }
+
         emit propertyUpdated();
     }
 }
@@ -4196,15 +4152,14 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
     int elapsedTime = lastMouseTime.elapsed();
     movedElapsed = lastMouseTime.elapsed();
 
-    if (mouseHistoryX.size() >= mouseHistorySize)
+    // The first tick after the timer was idle has no previous tick. Use
+    // the interval of the mouse timer for it.
+    qint64 tickNsecs = mouseRefreshRate * 1000000LL;
+    if (cursorTickTime.isValid())
     {
-        mouseHistoryX.removeLast();
-    }
-
-    if (mouseHistoryY.size() >= mouseHistorySize)
-    {
-        mouseHistoryY.removeLast();
+        tickNsecs = cursorTickTime.nsecsElapsed();
     }
+    cursorTickTime.start();
 
     /*
      * Combine all mouse events to find the distance to move the mouse
@@ -4212,46 +4167,28 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
      * The mouse smoothing technique used is an interpretation of the method
      * outlined at http://flipcode.net/archives/Smooth_Mouse_Filtering.shtml.
      */
-    if (cursorXSpeeds.length() == cursorYSpeeds.length() &&
-        cursorXSpeeds.length() > 0)
+    if (cursorSpeedSlots.size() > 0)
     {
-        int queueLength = cursorXSpeeds.length();
+        int queueLength = cursorSpeedSlots.size();
         for (int i=0; i < queueLength; i++)
         {
-            mouseCursorInfo infoX = cursorXSpeeds.takeFirst();
-            mouseCursorInfo infoY = cursorYSpeeds.takeFirst();
-            finalx += infoX.code;
-            finaly += infoY.code;
+            finalx += cursorXSpeeds.at(i);
+            finaly += cursorYSpeeds.at(i);
 
-            infoX.slot->getMouseInterval()->restart();
-            infoY.slot->getMouseInterval()->restart();
+            cursorSpeedSlots.at(i)->getMouseInterval()->restart();
         }
 
         finalx += cursorRemainderX;
-        mouseHistoryX.prepend(finalx);
+        mouseHistoryX.add(finalx, weightModifier);
         finaly += cursorRemainderY;
-        mouseHistoryY.prepend(finaly);
+        mouseHistoryY.add(finaly, weightModifier);
 
         cursorRemainderX = 0;
         cursorRemainderY = 0;
 
-        double adjustedX = 0;
-        double adjustedY = 0;
-
-        QListIterator<double> iterX(mouseHistoryX);
-        double currentWeight = 1.0;
-        double weightModifier = JoyButton::weightModifier;
-        double finalWeight = 0.0;
-
         //qDebug() << "OG: " << finalx;
-        while (iterX.hasNext())
-        {
-            double temp = iterX.next();
-            //qDebug() << "SAMPLE: " << temp;
-            adjustedX += temp * currentWeight;
-            finalWeight += currentWeight;
-            currentWeight *= weightModifier;
-        }
+        double adjustedX = mouseHistoryX.getWeightedSum();
+        double finalWeight = mouseHistoryX.getTotalWeight();
 
         //qDebug();
         //qDebug() << "X TO THE Z: " << adjustedX;
@@ -4277,17 +4214,8 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
         }
         //qDebug() << "FINAL X TO THE Z: " << adjustedX;
 
-        QListIterator<double> iterY(mouseHistoryY);
-        currentWeight = 1.0;
-        finalWeight = 0.0;
-
-        while (iterY.hasNext())
-        {
-            double temp = iterY.next();
-            adjustedY += temp * currentWeight;
-            finalWeight += currentWeight;
-            currentWeight *= weightModifier;
-        }
+        double adjustedY = mouseHistoryY.getWeightedSum();
+        finalWeight = mouseHistoryY.getTotalWeight();
 
         if (fabs(adjustedY) > 0)
         {
@@ -4308,11 +4236,35 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
             }
         }
 
-        // This check is more of a precaution than anything. No need to cause
-        // a sync to happen when not needed.
-        if (adjustedX != 0 || adjustedY != 0)
+        if (mouseMotionThread)
+        {
+            // Hand the smoothed movement to the motion thread as a
+            // velocity. The thread measures its own elapsed time and
+            // keeps the fractional remainder itself.
+            if (tickNsecs > 0)
+            {
+                double smoothedX = adjustedX + cursorRemainderX;
+                double smoothedY = adjustedY + cursorRemainderY;
+                mouseMotionThread->setVelocity(smoothedX * 1000000000.0 / tickNsecs,
+                                               smoothedY * 1000000000.0 / tickNsecs);
+
+                if (smoothedX != 0 || smoothedY != 0)
+                {
+                    invalidateSpringCursorLocation();
+                }
+            }
+
+            cursorRemainderX = 0;
+            cursorRemainderY = 0;
+        }
+        else
         {
-            sendevent(adjustedX, adjustedY);
+            // This check is more of a precaution than anything. No need to cause
+            // a sync to happen when not needed.
+            if (adjustedX != 0 || adjustedY != 0)
+            {
+                sendevent(adjustedX, adjustedY);
+            }
         }
 
         //qDebug() << "FINAL X: " << finalx;
@@ -4326,33 +4278,29 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
     }
     else
     {
-        mouseHistoryX.prepend(0);
-        mouseHistoryY.prepend(0);
+        mouseHistoryX.add(0, weightModifier);
+        mouseHistoryY.add(0, weightModifier);
+
+        if (mouseMotionThread)
+        {
+            mouseMotionThread->clearVelocity();
+        }
     }
 
     lastMouseTime.restart();
 
-    // Check if mouse event timer should use idle time.
+    // Check if mouse event timer should be stopped.
     if (pendingMouseButtons.length() == 0)
     {
-        if (staticMouseEventTimer.interval() != IDLEMOUSEREFRESHRATE)
-        {
-            staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
-
-            // Clear current mouse history
-            mouseHistoryX.clear();
-            mouseHistoryY.clear();
-
-            // Fill history with zeroes.
-            for (int i=0; i < mouseHistorySize; i++)
-            {
-                mouseHistoryX.append(0);
-                mouseHistoryY.append(0);
-            }
-        }
+        stopIdleMouseEventTimer();
 
         cursorRemainderX = 0;
         cursorRemainderY = 0;
+
+        if (mouseMotionThread)
+        {
+            mouseMotionThread->clearVelocity();
+        }
     }
     else
     {
@@ -4364,8 +4312,9 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed)
 
     }
 
-    cursorXSpeeds.clear();
-    cursorYSpeeds.clear();
+    cursorSpeedSlots.resize(0);
+    cursorXSpeeds.resize(0);
+    cursorYSpeeds.resize(0);
 }
 
 /**
@@ -4479,8 +4428,7 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved)
     // Check if mouse event timer should be stopped.
     if (pendingMouseButtons.length() == 0)
     {
-        staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
-        //staticMouseEventTimer.stop();
+        stopIdleMouseEventTimer();
     }
     else
     {
@@ -4705,8 +4653,26 @@ void JoyButton::establishMouseTimerConnections()
     connect(&staticMouseEventTimer, SIGNAL(timeout()), &mouseHelper, SLOT(mouseEvent()), Qt::UniqueConnection);
     if (!staticMouseEventTimer.isActive())
     {
+        // The timer is started by the first mouse slot activation.
         lastMouseTime.start();
-        staticMouseEventTimer.start(IDLEMOUSEREFRESHRATE);
+    }
+}
+
+/**
+ * @brief Stop the mouse event timer once no mouse movement is pending.
+ *     Nothing needs to run while the engine is idle. The next mouse slot
+ *     activation starts the timer again.
+ */
+void JoyButton::stopIdleMouseEventTimer()
+{
+    if (staticMouseEventTimer.isActive())
+    {
+        staticMouseEventTimer.stop();
+        cursorTickTime.invalidate();
+
+        // Fill history with zeroes.
+        mouseHistoryX.fill(0, weightModifier);
+        mouseHistoryY.fill(0, weightModifier);
     }
 }
 
@@ -4729,6 +4695,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
 {
     destButton->eventReset();
     destButton->assignments.clear();
+    destButton->compileSlotProgram();
     QListIterator<JoyButtonSlot*> iter(assignments);
     while (iter.hasNext())
     {
@@ -4747,6 +4714,8 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->wheelSpeedY = wheelSpeedY;
     destButton->mouseMode = mouseMode;
     destButton->mouseCurve = mouseCurve;
+    destButton->mouseCurvePoints = mouseCurvePoints;
+    destButton->mouseCurveTable = mouseCurveTable;
     destButton->springWidth = springWidth;
     destButton->springHeight = springHeight;
     destButton->sensitivity = sensitivity;
@@ -4819,6 +4788,154 @@ int JoyButton::calculateFinalMouseSpeed(JoyMouseCurve curve, int value)
     return result;
 }
 
+/**
+ * @brief Rebuild the lookup table for the assigned mouse curve. Curves that
+ *     do not depend on button settings share one table between buttons.
+ *     A power curve with a sensitivity below 1 does not use a table.
+ */
+void JoyButton::updateMouseCurveTable()
+{
+    bool presetCurve = mouseCurve != PowerCurve && mouseCurve != CustomCurve;
+    if (presetCurve && presetMouseCurveTables.contains(mouseCurve))
+    {
+        mouseCurveTable = presetMouseCurveTables.value(mouseCurve);
+    }
+    else if (mouseCurve == PowerCurve && sensitivity < 1.0)
+    {
+        // Always calculated directly in mouseEvent.
+        mouseCurveTable.clear();
+    }
+    else
+    {
+        MouseCurveTable tempTable;
+        for (int i=0; i <= MouseCurveTable::TABLESIZE; i++)
+        {
+            double distance = MouseCurveTable::getDistanceForIndex(i);
+            tempTable.setValue(i, calculateMouseCurveValue(mouseCurve, distance,
+                                                           sensitivity, mouseCurvePoints));
+        }
+
+        if (presetCurve)
+        {
+            presetMouseCurveTables.insert(mouseCurve, tempTable);
+        }
+
+        mouseCurveTable = tempTable;
+    }
+}
+
+/**
+ * @brief Evaluate the part of a mouse curve that only depends on the
+ *     distance from the dead zone. Quadratic Extreme applies its boost and
+ *     the easing curves apply their time based acceleration on top of this
+ *     value in mouseEvent.
+ * @param Mouse curve
+ * @param Distance from the dead zone in the range of 0.0 - 1.0
+ * @param Sensitivity used by the power curve
+ * @param Points used by the custom curve
+ * @return Curve value
+ */
+double JoyButton::calculateMouseCurveValue(JoyMouseCurve curve, double distance,
+                                           double sensitivity,
+                                           const QList<QPointF> &points)
+{
+    double difference = distance;
+
+    switch (curve)
+    {
+        case LinearCurve:
+        {
+            break;
+        }
+        case QuadraticCurve:
+        case QuadraticExtremeCurve:
+        {
+            difference = difference * difference;
+            break;
+        }
+        case CubicCurve:
+        {
+            difference = difference * difference * difference;
+            break;
+        }
+        case PowerCurve:
+        {
+            double tempsensitive = qMin(qMax(sensitivity, 1.0e-3), 1.0e+3);
+            double temp = qMin(qMax(pow(difference, 1.0 / tempsensitive), 0.0), 1.0);
+            difference = temp;
+            break;
+        }
+        case EnhancedPrecisionCurve:
+        case EasingQuadraticCurve:
+        case EasingCubicCurve:
+        {
+            // Perform different forms of acceleration depending on
+            // the range of the element from its assigned dead zone.
+            // Useful for more precise controls with an axis.
+            double temp = difference;
+            if (temp <= 0.4)
+            {
+                // Low slope value for really slow acceleration
+                difference = difference * 0.405; // Experimental
+            }
+            else if (temp <= 0.8)
+            {
+                // Perform Linear accleration with an appropriate
+                // offset.
+                difference = difference - 0.238; // Experimental
+            }
+            else if (temp > 0.8)
+            {
+                // Perform mouse acceleration. Make up the difference
+                // due to the previous two segments. Maxes out at 1.0.
+                difference = (difference * 2.19) - 1.19; // Experimental
+            }
+
+            break;
+        }
+        case CustomCurve:
+        {
+            // Interpolate between the assigned points. The curve starts
+            // at 0 and keeps the value of the last point past its end.
+            // A curve without points is linear.
+            if (!points.isEmpty())
+            {
+                double lastX = 0.0;
+                double lastY = 0.0;
+                bool found = false;
+
+                QListIterator<QPointF> iter(points);
+                while (iter.hasNext() && !found)
+                {
+                    QPointF point = iter.next();
+                    if (difference <= point.x())
+                    {
+                        double rangeX = point.x() - lastX;
+                        difference = (rangeX > 0.0) ?
+                                    lastY + ((point.y() - lastY) * ((difference - lastX) / rangeX)) :
+                                    point.y();
+                        found = true;
+                    }
+                    else
+                    {
+                        lastX = point.x();
+                        lastY = point.y();
+                    }
+                }
+
+                if (!found)
+                {
+                    difference = lastY;
+                }
+            }
+
+            break;
+        }
+    }
+
+    return difference;
+}
+
 void JoyButton::setEasingDuration(double value)
 {
     if (value >= MINIMUMEASINGDURATION && value <= MAXIMUMEASINGDURATION &&
@@ -4850,7 +4967,7 @@ QList<JoyButton*>* JoyButton::getPendingMouseButtons()
 
 bool JoyButton::hasCursorEvents()
 {
-    return (cursorXSpeeds.length() != 0) || (cursorYSpeeds.length() != 0);
+    return cursorSpeedSlots.size() != 0;
 }
 
 bool JoyButton::hasSpringEvents()
@@ -4888,8 +5005,8 @@ void JoyButton::setMouseHistorySize(int size)
 {
     if (size >= 1 && size <= MAXIMUMMOUSEHISTORYSIZE)
     {
-        mouseHistoryX.clear();
-        mouseHistoryY.clear();
+        mouseHistoryX.setSize(size);
+        mouseHistoryY.setSize(size);
 
         mouseHistorySize = size;
     }
@@ -4937,6 +5054,29 @@ void JoyButton::setMouseRefreshRate(int refresh)
     }
 }
 
+MouseMotionThread* JoyButton::getMouseMotionThread()
+{
+    return mouseMotionThread;
+}
+
+/**
+ * @brief Set the thread used to move the cursor in cursor mode. While a
+ *     thread is set, cursor mode events publish a velocity to the thread
+ *     instead of moving the cursor directly.
+ * @param Motion thread. 0 to move the cursor from the GUI thread.
+ */
+void JoyButton::setMouseMotionThread(MouseMotionThread *thread)
+{
+    if (mouseMotionThread)
+    {
+        mouseMotionThread->clearVelocity();
+    }
+
+    mouseMotionThread = thread;
+    cursorRemainderX = 0;
+    cursorRemainderY = 0;
+}
+
 /**
  * @brief Check if turbo should be disabled for a slot
  * @param JoyButtonSlot to check
@@ -4989,9 +5129,11 @@ void JoyButton::resetProperties()
     wheelSpeedY = 20;
     mouseMode = MouseCursor;
     mouseCurve = DEFAULTMOUSECURVE;
+    mouseCurvePoints.clear();
     springWidth = 0;
     springHeight = 0;
     sensitivity = 1.0;
+    updateMouseCurveTable();
     smoothing = false;
     setSelection = -1;
     setSelectionCondition = SetChangeDisabled;
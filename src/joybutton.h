@@ -6,15 +6,22 @@
 #include <QElapsedTimer>
 #include <QTime>
 #include <QList>
+#include <QVector>
 #include <QListIterator>
 #include <QHash>
 #include <QQueue>
+#include <QPointF>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 #include "joybuttonslot.h"
 #include "springmousemoveinfo.h"
 #include "joybuttonmousehelper.h"
+#include "inputlatencytracer.h"
+#include "buttontimer.h"
+#include "joybuttonslotprogram.h"
+#include "mousehistorybuffer.h"
+#include "mousecurvetable.h"
 
 #ifdef Q_OS_WIN
   #include "joykeyrepeathelper.h"
@@ -22,6 +29,7 @@
 
 class VDPad;
 class SetJoystick;
+class MouseMotionThread;
 
 class JoyButton : public QObject
 {
@@ -36,7 +44,7 @@ public:
     enum JoyMouseMovementMode {MouseCursor=0, MouseSpring};
     enum JoyMouseCurve {EnhancedPrecisionCurve=0, LinearCurve, QuadraticCurve,
                         CubicCurve, QuadraticExtremeCurve, PowerCurve,
-                        EasingQuadraticCurve, EasingCubicCurve};
+                        EasingQuadraticCurve, EasingCubicCurve, CustomCurve};
     enum TurboMode {NormalTurbo=0, GradientTurbo, PulseTurbo};
 
     void joyEvent(bool pressed, bool ignoresets=false);
@@ -90,6 +98,7 @@ public:
     SetChangeCondition getChangeSetCondition();
 
     bool getButtonState();
+    bool isNeutral();
     int getOriginSet();
 
     bool containsSequence();
@@ -114,6 +123,9 @@ public:
     void setMouseCurve(JoyMouseCurve selectedCurve);
     JoyMouseCurve getMouseCurve();
 
+    void setMouseCurvePoints(QList<QPointF> points);
+    QList<QPointF> getMouseCurvePoints();
+
     int getSpringWidth();
     int getSpringHeight();
 
@@ -166,6 +178,11 @@ public:
     static int getMouseRefreshRate();
     static void setMouseRefreshRate(int refresh);
 
+    static void stopIdleMouseEventTimer();
+
+    static MouseMotionThread* getMouseMotionThread();
+    static void setMouseMotionThread(MouseMotionThread *thread);
+
     static int getSpringModeScreen();
     static void setSpringModeScreen(int screen);
 
@@ -234,6 +251,8 @@ public:
 
     static const int MAXIMUMMOUSEREFRESHRATE;
     static const int IDLEMOUSEREFRESHRATE;
+    static const int CURSORSPEEDRESERVE;
+    static const int MAXIMUMMOUSECURVEPOINTS;
 
     static const double DEFAULTEXTRACCELVALUE;
     static const double DEFAULTMINACCELTHRESHOLD;
@@ -241,8 +260,8 @@ public:
     static const double DEFAULTSTARTACCELMULTIPLIER;
     static const double DEFAULTACCELEASINGDURATION;
 
-    static QList<double> mouseHistoryX;
-    static QList<double> mouseHistoryY;
+    static MouseHistoryBuffer mouseHistoryX;
+    static MouseHistoryBuffer mouseHistoryY;
 
     static double cursorRemainderX;
     static double cursorRemainderY;
@@ -255,6 +274,12 @@ protected:
     void findReleaseEventEnd();
     void findReleaseEventIterEnd(QListIterator<JoyButtonSlot*> *tempiter);
     void findHoldEventEnd();
+    int slotPositionAfter(JoyButtonSlot *slot, int from=0);
+    void compileSlotProgram();
+    void updateMouseCurveTable();
+    static double calculateMouseCurveValue(JoyMouseCurve curve, double distance,
+                                           double sensitivity,
+                                           const QList<QPointF> &points);
     bool checkForDelaySequence();
     void checkForPressedSetChange();
     bool insertAssignedSlot(JoyButtonSlot *newSlot);
@@ -265,12 +290,6 @@ protected:
 
     virtual bool readButtonConfig(QXmlStreamReader *xml);
 
-    typedef struct mouseCursorInfo
-    {
-        JoyButtonSlot *slot;
-        double code;
-    } mouseCursorInfo;
-
     // Used to denote whether the actual joypad button is pressed
     bool isButtonPressed;
     // Used to denote whether the virtual key is pressed
@@ -281,19 +300,19 @@ protected:
     int index;
     int turboInterval;
 
-    QTimer turboTimer;
-    QTimer pauseTimer;
-    QTimer holdTimer;
-    QTimer pauseWaitTimer;
-    QTimer createDeskTimer;
-    QTimer releaseDeskTimer;
-    QTimer mouseWheelVerticalEventTimer;
-    QTimer mouseWheelHorizontalEventTimer;
-    QTimer setChangeTimer;
-    QTimer keyPressTimer;
-    QTimer delayTimer;
+    ButtonTimer turboTimer;
+    ButtonTimer pauseTimer;
+    ButtonTimer holdTimer;
+    ButtonTimer pauseWaitTimer;
+    ButtonTimer createDeskTimer;
+    ButtonTimer releaseDeskTimer;
+    ButtonTimer mouseWheelVerticalEventTimer;
+    ButtonTimer mouseWheelHorizontalEventTimer;
+    ButtonTimer setChangeTimer;
+    ButtonTimer keyPressTimer;
+    ButtonTimer delayTimer;
     //QTimer keyRepeatTimer;
-    QTimer slotSetChangeTimer;
+    ButtonTimer slotSetChangeTimer;
     static QTimer staticMouseEventTimer;
 
     bool isDown;
@@ -312,7 +331,10 @@ protected:
     SetChangeCondition setSelectionCondition;
     int originset;
 
-    QListIterator<JoyButtonSlot*> *slotiter;
+    JoyButtonSlotProgram slotProgram;
+    // Position of the active sequence in the slot program.
+    // -1 when no sequence has been started.
+    int slotPosition;
     JoyButtonSlot *currentPause;
     JoyButtonSlot *currentHold;
     JoyButtonSlot *currentCycle;
@@ -337,6 +359,7 @@ protected:
     QTime wheelVerticalTime;
     QTime wheelHorizontalTime;
     static QTime lastMouseTime;
+    static QElapsedTimer cursorTickTime;
 
     QQueue<bool> ignoreSetQueue;
     QQueue<bool> isButtonPressedQueue;
@@ -350,6 +373,10 @@ protected:
     bool ignoreEvents;
     JoyMouseMovementMode mouseMode;
     JoyMouseCurve mouseCurve;
+    // Points of a CustomCurve sorted by distance.
+    QList<QPointF> mouseCurvePoints;
+    // Static part of the current mouse curve evaluated ahead of time.
+    MouseCurveTable mouseCurveTable;
 
     int springWidth;
     int springHeight;
@@ -398,6 +425,9 @@ protected:
     unsigned int cycleResetInterval;
     QTime cycleResetHold;
 
+    // Trace state of the event that last changed the button state.
+    InputLatencyTracer::TraceContext latencyContext;
+
     bool relativeSpring;
     TurboMode currentTurboMode;
 
@@ -409,13 +439,16 @@ protected:
     static double mouseSpeedModifier;
     static QList<JoyButtonSlot*> mouseSpeedModList;
 
-    static QList<mouseCursorInfo> cursorXSpeeds;
-    static QList<mouseCursorInfo> cursorYSpeeds;
+    static QVector<JoyButtonSlot*> cursorSpeedSlots;
+    static QVector<double> cursorXSpeeds;
+    static QVector<double> cursorYSpeeds;
 
     static QList<PadderCommon::springModeInfo> springXSpeeds;
     static QList<PadderCommon::springModeInfo> springYSpeeds;
 
     static QList<JoyButton*> pendingMouseButtons;
+    // Tables for curves that do not depend on button settings.
+    static QHash<int, MouseCurveTable> presetMouseCurveTables;
 
     static QHash<unsigned int, int> activeKeys;
     static QHash<unsigned int, int> activeMouseButtons;
@@ -429,6 +462,7 @@ protected:
     static int mouseHistorySize;
     static int mouseRefreshRate;
     static int springModeScreen;
+    static MouseMotionThread *mouseMotionThread;
 
 signals:
     void clicked (int index);
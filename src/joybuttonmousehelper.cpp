@@ -3,6 +3,7 @@
 
 #include "joybutton.h"
 #include "joybuttonmousehelper.h"
+#include "eventhandlerfactory.h"
 
 JoyButtonMouseHelper::JoyButtonMouseHelper(QObject *parent) :
     QObject(parent)
@@ -71,6 +72,8 @@ void JoyButtonMouseHelper::mouseEvent()
     {
         moveSpringMouse();
     }
+
+    EventHandlerFactory::flushHandlerEvents();
 }
 
 void JoyButtonMouseHelper::resetButtonMouseDistances()
@@ -0,0 +1,135 @@
+//#include <QDebug>
+
+#include "joybuttonslotprogram.h"
+
+JoyButtonSlotProgram::JoyButtonSlotProgram()
+{
+    distanceSlots = false;
+    releaseSlots = false;
+    sequenceSlots = false;
+}
+
+/**
+ * @brief Build the instruction array for a list of assignments. Jump
+ *     targets are resolved in a single backwards pass.
+ * @param Slots assigned to a button
+ */
+void JoyButtonSlotProgram::compile(const QList<JoyButtonSlot*> &assignments)
+{
+    clear();
+
+    int count = assignments.size();
+    instructions.resize(count);
+
+    int lastSegmentEnd = count;
+    int lastCycle = count;
+    for (int i = count - 1; i >= 0; i--)
+    {
+        JoyButtonSlot *slot = assignments.at(i);
+        Instruction &instruction = instructions[i];
+        instruction.slot = slot;
+        instruction.mode = slot->getSlotMode();
+        instruction.code = slot->getSlotCode();
+
+        switch (instruction.mode)
+        {
+            case JoyButtonSlot::JoyCycle:
+            {
+                lastCycle = i;
+                lastSegmentEnd = i;
+                break;
+            }
+            case JoyButtonSlot::JoyRelease:
+            {
+                releaseSlots = true;
+                lastSegmentEnd = i;
+                break;
+            }
+            case JoyButtonSlot::JoyHold:
+            {
+                sequenceSlots = true;
+                lastSegmentEnd = i;
+                break;
+            }
+            case JoyButtonSlot::JoyDistance:
+            {
+                distanceSlots = true;
+                sequenceSlots = true;
+                break;
+            }
+            case JoyButtonSlot::JoyPause:
+            {
+                sequenceSlots = true;
+                break;
+            }
+            default:
+                break;
+        }
+
+        instruction.segmentEnd = lastSegmentEnd;
+        instruction.nextCycle = lastCycle;
+        slotPositions.insert(slot, i);
+    }
+}
+
+void JoyButtonSlotProgram::clear()
+{
+    instructions.clear();
+    slotPositions.clear();
+    distanceSlots = false;
+    releaseSlots = false;
+    sequenceSlots = false;
+}
+
+/**
+ * @brief Find the end of the segment that contains a position. A segment
+ *     ends before the next release, hold or cycle instruction.
+ * @param Starting position
+ * @return Position of the instruction ending the segment or the program
+ *     size if no instruction ends it.
+ */
+int JoyButtonSlotProgram::segmentEnd(int position) const
+{
+    int result = instructions.size();
+    if (position >= 0 && position < result)
+    {
+        result = instructions.at(position).segmentEnd;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the next cycle instruction at or after a position.
+ * @param Starting position
+ * @return Position of the cycle instruction or the program size if there
+ *     is none.
+ */
+int JoyButtonSlotProgram::nextCycle(int position) const
+{
+    int result = instructions.size();
+    if (position >= 0 && position < result)
+    {
+        result = instructions.at(position).nextCycle;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the position of a slot that comes at or after a position.
+ * @param Slot to find
+ * @param Position to start from
+ * @return Position of the slot. -1 if the slot is not part of the program
+ *     or comes before the starting position.
+ */
+int JoyButtonSlotProgram::indexOf(JoyButtonSlot *slot, int from) const
+{
+    int result = slotPositions.value(slot, -1);
+    if (result < from)
+    {
+        result = -1;
+    }
+
+    return result;
+}
@@ -0,0 +1,75 @@
+#ifndef JOYBUTTONSLOTPROGRAM_H
+#define JOYBUTTONSLOTPROGRAM_H
+
+#include <QList>
+#include <QVector>
+#include <QHash>
+
+#include "joybuttonslot.h"
+
+/**
+ * @brief Flat representation of the slots assigned to a button. The
+ *     assignment list is compiled into an array of instructions whose
+ *     jump targets are resolved ahead of time so the slot engine can
+ *     execute a sequence without rescanning the assignment list.
+ *     Positions follow QListIterator semantics: a position sits before the
+ *     instruction with the same index and size() is the end of the program.
+ */
+class JoyButtonSlotProgram
+{
+public:
+    typedef struct Instruction
+    {
+        JoyButtonSlot *slot;
+        JoyButtonSlot::JoySlotInputAction mode;
+        int code;
+        // Position of the next release, hold or cycle instruction at or
+        // after this one. Equal to the program size when none exists.
+        int segmentEnd;
+        // Position of the next cycle instruction at or after this one.
+        int nextCycle;
+    } Instruction;
+
+    explicit JoyButtonSlotProgram();
+
+    void compile(const QList<JoyButtonSlot*> &assignments);
+    void clear();
+
+    inline int size() const
+    {
+        return instructions.size();
+    }
+
+    inline const Instruction& at(int position) const
+    {
+        return instructions.at(position);
+    }
+
+    int segmentEnd(int position) const;
+    int nextCycle(int position) const;
+    int indexOf(JoyButtonSlot *slot, int from=0) const;
+
+    inline bool hasDistanceSlots() const
+    {
+        return distanceSlots;
+    }
+
+    inline bool hasReleaseSlots() const
+    {
+        return releaseSlots;
+    }
+
+    inline bool hasSequenceSlots() const
+    {
+        return sequenceSlots;
+    }
+
+protected:
+    QVector<Instruction> instructions;
+    QHash<JoyButtonSlot*, int> slotPositions;
+    bool distanceSlots;
+    bool releaseSlots;
+    bool sequenceSlots;
+};
+
+#endif // JOYBUTTONSLOTPROGRAM_H
@@ -26,20 +26,28 @@ bool JoyButtonStatusBox::isButtonFlashing()
 
 void JoyButtonStatusBox::flash()
 {
-    isflashing = true;
+    flashState.flash(this);
+}
 
-    this->style()->unpolish(this);
-    this->style()->polish(this);
+void JoyButtonStatusBox::unflash()
+{
+    flashState.unflash(this);
+}
 
-    emit flashed(isflashing);
+void JoyButtonStatusBox::applyFrameUpdate()
+{
+    applyFlashState(flashState.takeFrameState(this));
 }
 
-void JoyButtonStatusBox::unflash()
+void JoyButtonStatusBox::applyFlashState(bool flashing)
 {
-    isflashing = false;
+    if (isflashing != flashing)
+    {
+        isflashing = flashing;
 
-    this->style()->unpolish(this);
-    this->style()->polish(this);
+        this->style()->unpolish(this);
+        this->style()->polish(this);
 
-    emit flashed(isflashing);
+        emit flashed(isflashing);
+    }
 }
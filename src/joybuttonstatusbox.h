@@ -4,6 +4,7 @@
 #include <QPushButton>
 
 #include "joybutton.h"
+#include "uiupdatebus.h"
 
 class JoyButtonStatusBox : public QPushButton
 {
@@ -16,8 +17,11 @@ public:
     bool isButtonFlashing();
 
 protected:
+    void applyFlashState(bool flashing);
+
     JoyButton *button;
     bool isflashing;
+    UiFlashState flashState;
 
 signals:
     void flashed(bool flashing);
@@ -25,6 +29,7 @@ signals:
 private slots:
     void flash();
     void unflash();
+    void applyFrameUpdate();
 };
 
 #endif // JOYBUTTONSTATUSBOX_H
@@ -147,10 +147,18 @@ void JoyControlStick::joyEvent(bool ignoresets)
 
 bool JoyControlStick::inDeadZone()
 {
-    int axis1Value = axisX->getCurrentRawValue();
-    int axis2Value = axisY->getCurrentRawValue();
+    return inDeadZone(axisX->getCurrentRawValue(), axisY->getCurrentRawValue());
+}
 
-    unsigned int squareDist = (unsigned int)(axis1Value*axis1Value) + (unsigned int)(axis2Value*axis2Value);
+/**
+ * @brief Check if a stick position would be inside the assigned dead zone.
+ * @param X axis value
+ * @param Y axis value
+ * @return Whether the position is inside the dead zone
+ */
+bool JoyControlStick::inDeadZone(int axisXValue, int axisYValue)
+{
+    unsigned int squareDist = (unsigned int)(axisXValue*axisXValue) + (unsigned int)(axisYValue*axisYValue);
 
     return squareDist <= (unsigned int)(deadZone*deadZone);
 }
@@ -337,10 +345,55 @@ double JoyControlStick::calculateBearing()
  */
 double JoyControlStick::calculateBearing(int axisXValue, int axisYValue)
 {
-    double finalAngle = 0.0;
+    return getPositionGeometry(axisXValue, axisYValue).bearing;
+}
+
+/**
+ * @brief Get the values derived from a stick position that are shared by the
+ *     direction and distance calculations. The result for the last position
+ *     is kept so the bearing and angle only get computed once per stick
+ *     event rather than once per calculation and mouse tick.
+ * @param X axis value
+ * @param Y axis value
+ * @return Geometry for the stick position
+ */
+const JoyControlStick::PositionGeometry& JoyControlStick::getPositionGeometry(int axisXValue, int axisYValue)
+{
+    if (geometry.valid && geometry.axisXValue == axisXValue &&
+        geometry.axisYValue == axisYValue)
+    {
+        return geometry;
+    }
+
     int axis1Value = axisXValue;
     int axis2Value = axisYValue;
 
+    unsigned int squared_dist = static_cast<unsigned int>(axis1Value*axis1Value)
+            + static_cast<unsigned int>(axis2Value*axis2Value);
+
+    geometry.axisXValue = axisXValue;
+    geometry.axisYValue = axisYValue;
+    geometry.valid = true;
+    geometry.distance = sqrt(squared_dist);
+
+    // Same results as sin and cos of atan2(x, -y) without the
+    // trigonometric calls.
+    if (squared_dist > 0)
+    {
+        geometry.angleSin = axis1Value / geometry.distance;
+        geometry.angleCos = -axis2Value / geometry.distance;
+    }
+    else
+    {
+        geometry.angleSin = 0.0;
+        geometry.angleCos = 1.0;
+    }
+
+    double ang_sin = geometry.angleSin;
+    double ang_cos = geometry.angleCos;
+    geometry.squareStickFullPhi = qMin(ang_sin ? 1/fabs(ang_sin) : 2, ang_cos ? 1/fabs(ang_cos) : 2);
+
+    double finalAngle = 0.0;
     if (axis1Value == 0 && axis2Value == 0)
     {
         finalAngle = 0.0;
@@ -374,7 +427,9 @@ double JoyControlStick::calculateBearing(int axisXValue, int axisYValue)
         }
     }
 
-    return finalAngle;
+    geometry.bearing = finalAngle;
+
+    return geometry;
 }
 
 double JoyControlStick::getDistanceFromDeadZone()
@@ -390,18 +445,10 @@ double JoyControlStick::getDistanceFromDeadZone(int axisXValue, int axisYValue)
 {
     double distance = 0.0;
 
-    int axis1Value = axisXValue;
-    int axis2Value = axisYValue;
-
-    double angle2 = atan2(axis1Value, -axis2Value);
-    double ang_sin = sin(angle2);
-    double ang_cos = cos(angle2);
+    const PositionGeometry &position = getPositionGeometry(axisXValue, axisYValue);
+    unsigned int dist = position.distance;
 
-    unsigned int squared_dist = static_cast<unsigned int>(axis1Value*axis1Value)
-            + static_cast<unsigned int>(axis2Value*axis2Value);
-    unsigned int dist = sqrt(squared_dist);
-
-    double squareStickFullPhi = qMin(ang_sin ? 1/fabs(ang_sin) : 2, ang_cos ? 1/fabs(ang_cos) : 2);
+    double squareStickFullPhi = position.squareStickFullPhi;
     double circle = this->circle;
     double circleStickFull = (squareStickFullPhi - 1) * circle + 1;
 
@@ -434,17 +481,15 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue, int axisY
 {
     double distance = 0.0;
 
-    int axis1Value = axisXValue;
     int axis2Value = axisYValue;
     //unsigned int square_dist = (unsigned int)(axis1Value*axis1Value) + (unsigned int)(axis2Value*axis2Value);
 
-    double angle2 = atan2(axis1Value, -axis2Value);
-    double ang_sin = sin(angle2);
-    double ang_cos = cos(angle2);
+    const PositionGeometry &position = getPositionGeometry(axisXValue, axisYValue);
+    double ang_cos = position.angleCos;
 
     int deadY = abs(floor(deadZone * ang_cos) + 0.5);
     //int axis2ValueCircleFull = (int)floor(JoyAxis::AXISMAX * fabs(ang_cos) + 0.5);
-    double squareStickFullPhi = qMin(ang_sin ? 1/fabs(ang_sin) : 2, ang_cos ? 1/fabs(ang_cos) : 2);
+    double squareStickFullPhi = position.squareStickFullPhi;
     double circle = this->circle;
     double circleStickFull = (squareStickFullPhi - 1) * circle + 1;
     //double circleToSquareTest = axis2Value * squareStickFullPhi;
@@ -456,44 +501,32 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue, int axisY
     {
         if (currentDirection == StickRightUp || currentDirection == StickUp)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(3);
-            double minangle = tempangles.at(1);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadY = fabs(square_dist * sin((minangle) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadY = fabs(square_dist * diagonalZoneDeadYFactors[0]);
             double currentDeadY = qMax(static_cast<double>(adjustedDeadYZone), mindeadY);
             double tempdist4 = (fabs(adjustedAxis2Value) - currentDeadY) / static_cast<double>(maxZone - currentDeadY);
             distance = tempdist4;
         }
         else if (currentDirection == StickRightDown || currentDirection == StickRight)
         {
-            QList<double> tempfuck = getDiagonalZoneAngles();
-            double maxangle = tempfuck.at(5);
-            double minangle = tempfuck.at(4);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadY = fabs(square_dist * sin((minangle - 90.0) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadY = fabs(square_dist * diagonalZoneDeadYFactors[1]);
             double currentDeadY = qMax(static_cast<double>(adjustedDeadYZone), mindeadY);
             double tempdist4 = (fabs(adjustedAxis2Value) - currentDeadY) / static_cast<double>(maxZone - currentDeadY);
             distance = tempdist4;
         }
         else if (currentDirection == StickLeftDown || currentDirection == StickDown)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(7);
-            double minangle = tempangles.at(6);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadY = fabs(square_dist * sin((minangle - 180.0) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadY = fabs(square_dist * diagonalZoneDeadYFactors[2]);
             double currentDeadY = qMax(static_cast<double>(adjustedDeadYZone), mindeadY);
             double tempdist4 = (fabs(adjustedAxis2Value) - currentDeadY) / static_cast<double>(maxZone - currentDeadY);
             distance = tempdist4;
         }
         else if (currentDirection == StickLeftUp || currentDirection == StickLeft)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(1);
-            double minangle = tempangles.at(8);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadY = fabs(square_dist * sin((minangle - 270.0) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadY = fabs(square_dist * diagonalZoneDeadYFactors[3]);
             double currentDeadY = qMax(static_cast<double>(adjustedDeadYZone), mindeadY);
             double tempdist4 = (fabs(adjustedAxis2Value) - currentDeadY) / static_cast<double>(maxZone - currentDeadY);
             distance = tempdist4;
@@ -534,16 +567,14 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue, int axisY
     double distance = 0.0;
 
     int axis1Value = axisXValue;
-    int axis2Value = axisYValue;
     //unsigned int square_dist = (unsigned int)(axis1Value*axis1Value) + (unsigned int)(axis2Value*axis2Value);
 
-    double angle2 = atan2(axis1Value, -axis2Value);
-    double ang_sin = sin(angle2);
-    double ang_cos = cos(angle2);
+    const PositionGeometry &position = getPositionGeometry(axisXValue, axisYValue);
+    double ang_sin = position.angleSin;
 
     int deadX = abs((int)floor(deadZone * ang_sin + 0.5));
     //int axis1ValueCircleFull = (int)floor(JoyAxis::AXISMAX * fabs(ang_sin) + 0.5);
-    double squareStickFullPhi = qMin(ang_sin ? 1/fabs(ang_sin) : 2, ang_cos ? 1/fabs(ang_cos) : 2);
+    double squareStickFullPhi = position.squareStickFullPhi;
     double circle = this->circle;
     double circleStickFull = (squareStickFullPhi - 1) * circle + 1;
     //double alternateStickFullValue = circleStickFull * abs(axis1ValueCircleFull);
@@ -555,45 +586,32 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue, int axisY
     {
         if (currentDirection == StickRightUp || currentDirection == StickRight)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(3);
-            double minangle = tempangles.at(1);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadX = fabs(square_dist * cos(maxangle * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadX = fabs(square_dist * diagonalZoneDeadXFactors[0]);
             double currentDeadX = qMax(mindeadX, static_cast<double>(adjustedDeadXZone));
             double tempdist4 = (fabs(adjustedAxis1Value) - currentDeadX) / static_cast<double>(maxZone - currentDeadX);
             distance = tempdist4;
         }
         else if (currentDirection == StickRightDown || currentDirection == StickDown)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(5);
-            double minangle = tempangles.at(4);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadX = fabs(square_dist * cos((maxangle - 90.0) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadX = fabs(square_dist * diagonalZoneDeadXFactors[1]);
             double currentDeadX = qMax(mindeadX, static_cast<double>(adjustedDeadXZone));
             double tempdist4 = (fabs(adjustedAxis1Value) - currentDeadX) / static_cast<double>(maxZone - currentDeadX);
             distance = tempdist4;
         }
         else if (currentDirection == StickLeftDown || currentDirection == StickLeft)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(7);
-            double minangle = tempangles.at(6);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double mindeadX = fabs(square_dist * cos((maxangle - 180.0) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadX = fabs(square_dist * diagonalZoneDeadXFactors[2]);
             double currentDeadX = qMax(mindeadX, static_cast<double>(adjustedDeadXZone));
             double tempdist4 = (fabs(adjustedAxis1Value) - currentDeadX) / static_cast<double>(maxZone - currentDeadX);
             distance = tempdist4;
         }
         else if (currentDirection == StickLeftUp || currentDirection == StickUp)
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
-            double maxangle = tempangles.at(1);
-            double minangle = tempangles.at(8);
-            double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
-            double maxfuckX = fabs(square_dist * cos((minangle - 270.0) * PI / 180.0));
-            double mindeadX = fabs(square_dist * cos((maxangle - 270.0) * PI / 180.0));
+            double square_dist = position.distance;
+            double mindeadX = fabs(square_dist * diagonalZoneDeadXFactors[3]);
             double currentDeadX = qMax(mindeadX, static_cast<double>(adjustedDeadXZone));
             double tempdist4 = (fabs(adjustedAxis1Value) - currentDeadX) / static_cast<double>(maxZone - currentDeadX);
             distance = tempdist4;
@@ -833,6 +851,8 @@ void JoyControlStick::reset()
     deadZone = 8000;
     maxZone = JoyAxis::AXISMAXZONE;
     diagonalRange = 45;
+    updateDiagonalZoneAngles();
+    geometry.valid = false;
     isActive = false;
     pendingStickEvent = false;
 
@@ -911,6 +931,7 @@ void JoyControlStick::setDiagonalRange(int value)
     if (value != diagonalRange)
     {
         diagonalRange = value;
+        updateDiagonalZoneAngles();
         emit diagonalRangeChanged(value);
         emit propertyUpdated();
     }
@@ -1670,15 +1691,11 @@ int JoyControlStick::calculateCircleXValue(int rawXValue)
     int value = rawXValue;
     if (this->circle > 0.0)
     {
-        int axis1Value = axisX->getCurrentRawValue();
-        int axis2Value = axisY->getCurrentRawValue();
-
-        double angle2 = atan2(axis1Value, -axis2Value);
-        double ang_sin = sin(angle2);
-        double ang_cos = cos(angle2);
+        const PositionGeometry &position = getPositionGeometry(axisX->getCurrentRawValue(),
+                                                               axisY->getCurrentRawValue());
 
-        int axisXValueCircleFull = (int)floor(JoyAxis::AXISMAX * fabs(ang_sin) + 0.5);
-        double squareStickFull = qMin(ang_sin ? 1/fabs(ang_sin) : 2, ang_cos ? 1/fabs(ang_cos) : 2);
+        int axisXValueCircleFull = (int)floor(JoyAxis::AXISMAX * fabs(position.angleSin) + 0.5);
+        double squareStickFull = position.squareStickFullPhi;
         double circle = this->circle;
         double circleStickFull = (squareStickFull - 1) * circle + 1;
         double alternateStickFullValue = circleStickFull * abs(axisXValueCircleFull);
@@ -1694,15 +1711,11 @@ int JoyControlStick::calculateCircleYValue(int rawYValue)
     int value = rawYValue;
     if (this->circle > 0.0)
     {
-        int axis1Value = axisX->getCurrentRawValue();
-        int axis2Value = axisY->getCurrentRawValue();
+        const PositionGeometry &position = getPositionGeometry(axisX->getCurrentRawValue(),
+                                                               axisY->getCurrentRawValue());
 
-        double angle2 = atan2(axis1Value, -axis2Value);
-        double ang_sin = sin(angle2);
-        double ang_cos = cos(angle2);
-
-        int axisYValueCircleFull = (int)floor(JoyAxis::AXISMAX * fabs(ang_cos) + 0.5);
-        double squareStickFull = qMin(ang_sin ? 1/fabs(ang_sin) : 2, ang_cos ? 1/fabs(ang_cos) : 2);
+        int axisYValueCircleFull = (int)floor(JoyAxis::AXISMAX * fabs(position.angleCos) + 0.5);
+        double squareStickFull = position.squareStickFullPhi;
         double circle = this->circle;
         double circleStickFull = (squareStickFull - 1) * circle + 1;
         double alternateStickFullValue = circleStickFull * abs(axisYValueCircleFull);
@@ -1715,7 +1728,17 @@ int JoyControlStick::calculateCircleYValue(int rawYValue)
 
 QList<double> JoyControlStick::getDiagonalZoneAngles()
 {
-    QList<double> anglesList;
+    return diagonalZoneAngles;
+}
+
+/**
+ * @brief Rebuild the cached diagonal zone angles. Needs to be called
+ *     whenever the diagonal range changes.
+ */
+void JoyControlStick::updateDiagonalZoneAngles()
+{
+    QList<double> &anglesList = diagonalZoneAngles;
+    anglesList.clear();
 
     int diagonalAngle = diagonalRange;
 
@@ -1748,7 +1771,17 @@ QList<double> JoyControlStick::getDiagonalZoneAngles()
     anglesList.append(leftInitial);
     anglesList.append(upLeftInitial);
 
-    return anglesList;
+    // Factors used to find the minimum axis dead zone along the edges of
+    // each diagonal zone when interpolating axis distances.
+    diagonalZoneDeadYFactors[0] = sin(initialRight * PI / 180.0);
+    diagonalZoneDeadYFactors[1] = sin((downRightInitial - 90.0) * PI / 180.0);
+    diagonalZoneDeadYFactors[2] = sin((downLeftInitial - 180.0) * PI / 180.0);
+    diagonalZoneDeadYFactors[3] = sin((upLeftInitial - 270.0) * PI / 180.0);
+
+    diagonalZoneDeadXFactors[0] = cos(rightInitial * PI / 180.0);
+    diagonalZoneDeadXFactors[1] = cos((downInitial - 90.0) * PI / 180.0);
+    diagonalZoneDeadXFactors[2] = cos((leftInitial - 180.0) * PI / 180.0);
+    diagonalZoneDeadXFactors[3] = cos((initialRight - 270.0) * PI / 180.0);
 }
 
 QList<int> JoyControlStick::getFourWayCardinalZoneAngles()
@@ -2483,17 +2516,19 @@ void JoyControlStick::determineFourWayDiagonalEvent(JoyControlStickButton *&even
 }
 
 /**
- * @brief Find the current stick direction based on a Standard mode stick.
- * @return Current direction the stick is positioned.
+ * @brief Find the stick direction for a position based on a Standard mode stick.
+ * @param X axis value
+ * @param Y axis value
+ * @return Direction the stick is positioned in.
  */
-JoyControlStick::JoyStickDirections JoyControlStick::determineStandardModeDirection()
+JoyControlStick::JoyStickDirections JoyControlStick::determineStandardModeDirection(int axisXValue, int axisYValue)
 {
     JoyStickDirections result = StickCentered;
 
-    double bearing = calculateBearing();
+    double bearing = calculateBearing(axisXValue, axisYValue);
     //bearing = floor(bearing + 0.5);
 
-    QList<double> anglesList = getDiagonalZoneAngles();
+    const QList<double> &anglesList = diagonalZoneAngles;
     int initialLeft = anglesList.value(0);
     int initialRight = anglesList.value(1);
     int upRightInitial = anglesList.value(2);
@@ -2541,24 +2576,28 @@ JoyControlStick::JoyStickDirections JoyControlStick::determineStandardModeDirect
 }
 
 /**
- * @brief Find the current stick direction based on a Eight Way mode stick.
- * @return Current direction the stick is positioned.
+ * @brief Find the stick direction for a position based on a Eight Way mode stick.
+ * @param X axis value
+ * @param Y axis value
+ * @return Direction the stick is positioned in.
  */
-JoyControlStick::JoyStickDirections JoyControlStick::determineEightWayModeDirection()
+JoyControlStick::JoyStickDirections JoyControlStick::determineEightWayModeDirection(int axisXValue, int axisYValue)
 {
-    return determineStandardModeDirection();
+    return determineStandardModeDirection(axisXValue, axisYValue);
 }
 
 /**
- * @brief Find the current stick direction based on a Four Way Cardinal mode
+ * @brief Find the stick direction for a position based on a Four Way Cardinal mode
  *     stick.
- * @return Current direction the stick is positioned.
+ * @param X axis value
+ * @param Y axis value
+ * @return Direction the stick is positioned in.
  */
-JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayCardinalDirection()
+JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayCardinalDirection(int axisXValue, int axisYValue)
 {
     JoyStickDirections result = StickCentered;
 
-    double bearing = calculateBearing();
+    double bearing = calculateBearing(axisXValue, axisYValue);
     //bearing = floor(bearing + 0.5);
 
     QList<int> anglesList = getFourWayCardinalZoneAngles();
@@ -2588,15 +2627,17 @@ JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayCardinalDir
 }
 
 /**
- * @brief Find the current stick direction based on a Four Way Diagonal mode
+ * @brief Find the stick direction for a position based on a Four Way Diagonal mode
  *     stick.
- * @return Current direction the stick is positioned.
+ * @param X axis value
+ * @param Y axis value
+ * @return Direction the stick is positioned in.
  */
-JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayDiagonalDirection()
+JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayDiagonalDirection(int axisXValue, int axisYValue)
 {
     JoyStickDirections result = StickCentered;
 
-    double bearing = calculateBearing();
+    double bearing = calculateBearing(axisXValue, axisYValue);
     //bearing = floor(bearing + 0.5);
 
     QList<int> anglesList = getFourWayDiagonalZoneAngles();
@@ -2631,24 +2672,36 @@ JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayDiagonalDir
  * @return Current direction the stick is positioned.
  */
 JoyControlStick::JoyStickDirections JoyControlStick::calculateStickDirection()
+{
+    return calculateStickDirection(axisX->getCurrentRawValue(), axisY->getCurrentRawValue());
+}
+
+/**
+ * @brief Calculate the direction of the stick for a given position and the
+ *     current mode of the stick. Does not check the dead zone.
+ * @param X axis value
+ * @param Y axis value
+ * @return Direction the stick would be positioned in.
+ */
+JoyControlStick::JoyStickDirections JoyControlStick::calculateStickDirection(int axisXValue, int axisYValue)
 {
     JoyStickDirections result = StickCentered;
 
     if (currentMode == StandardMode)
     {
-        result = determineStandardModeDirection();
+        result = determineStandardModeDirection(axisXValue, axisYValue);
     }
     else if (currentMode == EightWayMode)
     {
-        result = determineEightWayModeDirection();
+        result = determineEightWayModeDirection(axisXValue, axisYValue);
     }
     else if (currentMode == FourWayCardinal)
     {
-        result = determineFourWayCardinalDirection();
+        result = determineFourWayCardinalDirection(axisXValue, axisYValue);
     }
     else if (currentMode == FourWayDiagonal)
     {
-        result = determineFourWayDiagonalDirection();
+        result = determineFourWayDiagonalDirection(axisXValue, axisYValue);
     }
 
     return result;
@@ -2738,6 +2791,7 @@ void JoyControlStick::copyAssignments(JoyControlStick *destStick)
     destStick->deadZone = deadZone;
     destStick->maxZone = maxZone;
     destStick->diagonalRange = diagonalRange;
+    destStick->updateDiagonalZoneAngles();
     destStick->currentDirection = currentDirection;
     destStick->currentMode = currentMode;
     destStick->stickName = stickName;
@@ -26,6 +26,8 @@ public:
     void joyEvent(bool ignoresets=false);
 
     bool inDeadZone();
+    bool inDeadZone(int axisXValue, int axisYValue);
+    JoyStickDirections calculateStickDirection(int axisXValue, int axisYValue);
     int getDeadZone();
     int getDiagonalRange();
 
@@ -173,10 +175,10 @@ protected:
     void determineFourWayCardinalEvent(JoyControlStickButton *&eventbutton1, JoyControlStickButton *&eventbutton2);
     void determineFourWayDiagonalEvent(JoyControlStickButton *&eventbutton3);
 
-    JoyControlStick::JoyStickDirections determineStandardModeDirection();
-    JoyControlStick::JoyStickDirections determineEightWayModeDirection();
-    JoyControlStick::JoyStickDirections determineFourWayCardinalDirection();
-    JoyControlStick::JoyStickDirections determineFourWayDiagonalDirection();
+    JoyControlStick::JoyStickDirections determineStandardModeDirection(int axisXValue, int axisYValue);
+    JoyControlStick::JoyStickDirections determineEightWayModeDirection(int axisXValue, int axisYValue);
+    JoyControlStick::JoyStickDirections determineFourWayCardinalDirection(int axisXValue, int axisYValue);
+    JoyControlStick::JoyStickDirections determineFourWayDiagonalDirection(int axisXValue, int axisYValue);
 
     JoyControlStick::JoyStickDirections calculateStickDirection();
 
@@ -200,6 +202,24 @@ protected:
     double calculateEightWayDiagonalDistanceFromDeadZone(int axisXValue, int axisYValue);
     double calculateRawEightWayDiagonalDistance(int axisXValue, int axisYValue);
 
+    // Values derived from a single stick position.
+    struct PositionGeometry
+    {
+        int axisXValue;
+        int axisYValue;
+        bool valid;
+        // Radial distance in the range of 0 - 32,767 * sqrt(2).
+        double distance;
+        // Sine and cosine of the angle measured clockwise from up.
+        double angleSin;
+        double angleCos;
+        double squareStickFullPhi;
+        double bearing;
+    };
+
+    const PositionGeometry& getPositionGeometry(int axisXValue, int axisYValue);
+    void updateDiagonalZoneAngles();
+
     QHash<JoyStickDirections, JoyControlStickButton*> getApplicableButtons();
     void clearPendingAxisEvents();
 
@@ -223,6 +243,10 @@ protected:
     QTimer directionDelayTimer;
     unsigned int stickDelay;
     bool pendingStickEvent;
+    PositionGeometry geometry;
+    QList<double> diagonalZoneAngles;
+    double diagonalZoneDeadXFactors[4];
+    double diagonalZoneDeadYFactors[4];
 
     QHash<JoyStickDirections, JoyControlStickButton*> buttons;
     JoyControlStickModifierButton *modifierButton;
@@ -6,6 +6,7 @@
 #include <QLinearGradient>
 
 #include "joycontrolstickstatusbox.h"
+#include "uiupdatebus.h"
 
 JoyControlStickStatusBox::JoyControlStickStatusBox(QWidget *parent) :
     QWidget(parent)
@@ -19,7 +20,7 @@ JoyControlStickStatusBox::JoyControlStickStatusBox(JoyControlStick *stick, QWidg
     this->stick = stick;
 
     connect(stick, SIGNAL(deadZoneChanged(int)), this, SLOT(update()));
-    connect(stick, SIGNAL(moved(int,int)), this, SLOT(update()));
+    connect(stick, SIGNAL(moved(int,int)), this, SLOT(scheduleFrameUpdate()));
     connect(stick, SIGNAL(diagonalRangeChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(maxZoneChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(joyModeChanged()), this, SLOT(update()));
@@ -39,12 +40,26 @@ void JoyControlStickStatusBox::setStick(JoyControlStick *stick)
 
     this->stick = stick;
     connect(stick, SIGNAL(deadZoneChanged(int)), this, SLOT(update()));
-    connect(stick, SIGNAL(moved(int,int)), this, SLOT(update()));
+    connect(stick, SIGNAL(moved(int,int)), this, SLOT(scheduleFrameUpdate()));
     connect(stick, SIGNAL(diagonalRangeChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(maxZoneChanged(int)), this, SLOT(update()));
     connect(stick, SIGNAL(joyModeChanged()), this, SLOT(update()));
 }
 
+/**
+ * @brief Repaint on the next frame of the UI update bus instead of on every
+ *     stick event.
+ */
+void JoyControlStickStatusBox::scheduleFrameUpdate()
+{
+    UiUpdateBus::getInstance()->scheduleUpdate(this);
+}
+
+void JoyControlStickStatusBox::applyFrameUpdate()
+{
+    update();
+}
+
 JoyControlStick* JoyControlStickStatusBox::getStick()
 {
     return stick;
@@ -32,7 +32,10 @@ protected:
 signals:
     
 public slots:
-    
+
+private slots:
+    void scheduleFrameUpdate();
+    void applyFrameUpdate();
 };
 
 #endif // JOYCONTROLSTICKSTATUSBOX_H
@@ -294,6 +294,16 @@ int JoyDPad::getCurrentDirection()
     return prevDirection;
 }
 
+/**
+ * @brief Check if the dpad is centered or already on its way back to the
+ *     center.
+ * @return DPad is neutral
+ */
+bool JoyDPad::isNeutral()
+{
+    return pendingDirection == JoyDPadButton::DpadCentered;
+}
+
 void JoyDPad::setJoyMode(JoyMode mode)
 {
     currentMode = mode;
@@ -23,6 +23,7 @@ public:
     QHash<int, JoyDPadButton*>* getJoyButtons();
 
     int getCurrentDirection();
+    bool isNeutral();
     int getJoyNumber();
     int getIndex();
     int getRealJoyNumber();
@@ -14,12 +14,14 @@ Joystick::Joystick(SDL_Joystick *joyhandle, int deviceIndex, AntiMicroSettings *
     joyNumber = SDL_JoystickIndex(joyhandle);
 #endif
 
-    for (int i=0; i < NUMBER_JOYSETS; i++)
-    {
-        SetJoystick *setstick = new SetJoystick(this, i, this);
-        joystick_sets.insert(i, setstick);
-        enableSetConnections(setstick);
-    }
+    // Only the first set is created up front. The other sets are
+    // created when they are first used.
+    getSetJoystick(0);
+}
+
+SetJoystick* Joystick::createSetJoystick(int index)
+{
+    return new SetJoystick(this, index, this);
 }
 
 QString Joystick::getName()
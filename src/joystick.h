@@ -29,6 +29,8 @@ public:
     static const QString xmlName;
 
 protected:
+    virtual SetJoystick* createSetJoystick(int index);
+
     SDL_Joystick *joyhandle;
 
 signals:
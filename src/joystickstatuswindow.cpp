@@ -1,5 +1,6 @@
 //#include <QDebug>
 #include <QProgressBar>
+#include <QFont>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -9,6 +10,8 @@
 #include "joystickstatuswindow.h"
 #include "ui_joystickstatuswindow.h"
 #include "joybuttonstatusbox.h"
+#include "inputlatencytracer.h"
+#include "uiupdatebus.h"
 
 
 JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *parent) :
@@ -55,7 +58,8 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
             hbox->addSpacing(10);
             axesBox->addLayout(hbox);
 
-            connect(axis, SIGNAL(moved(int)), axisBar, SLOT(setValue(int)));
+            axisBars.insert(axis, axisBar);
+            connect(axis, SIGNAL(moved(int)), this, SLOT(scheduleAxisUpdate(int)));
         }
     }
 
@@ -148,6 +152,19 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
     ui->sdlGameControllerLabel->setVisible(false);
 #endif
 
+    QFont reportFont("Monospace");
+    reportFont.setStyleHint(QFont::TypeWriter);
+    ui->latencyReportTextEdit->setFont(reportFont);
+    ui->latencyTracingCheckBox->setChecked(InputLatencyTracer::isEnabled());
+    refreshLatencyReport();
+
+    latencyReportTimer.setInterval(1000);
+    connect(&latencyReportTimer, SIGNAL(timeout()), this, SLOT(refreshLatencyReport()));
+    connect(ui->statusTabWidget, SIGNAL(currentChanged(int)), this, SLOT(updateLatencyReportTimer()));
+
+    connect(ui->latencyTracingCheckBox, SIGNAL(clicked(bool)), this, SLOT(changeLatencyTracing(bool)));
+    connect(ui->latencyResetPushButton, SIGNAL(clicked()), this, SLOT(resetLatencyReport()));
+
     connect(joystick, SIGNAL(destroyed()), this, SLOT(obliterate()));
     connect(this, SIGNAL(finished(int)), this, SLOT(restoreButtonStates(int)));
 }
@@ -168,5 +185,77 @@ void JoystickStatusWindow::restoreButtonStates(int code)
 
 void JoystickStatusWindow::obliterate()
 {
+    // The axes are removed along with the device.
+    axisBars.clear();
     this->done(QDialogButtonBox::DestructiveRole);
 }
+
+void JoystickStatusWindow::changeLatencyTracing(bool enabled)
+{
+    InputLatencyTracer::setEnabled(enabled);
+    refreshLatencyReport();
+}
+
+void JoystickStatusWindow::refreshLatencyReport()
+{
+    ui->latencyReportTextEdit->setPlainText(InputLatencyTracer::getInstance()->generateReport());
+}
+
+/**
+ * @brief Only refresh the latency report while it can be seen. Generating
+ *     the report walks every recorded sample.
+ */
+void JoystickStatusWindow::updateLatencyReportTimer()
+{
+    bool reportVisible = isVisible() &&
+            ui->statusTabWidget->currentWidget() == ui->latencyTab;
+
+    if (reportVisible && !latencyReportTimer.isActive())
+    {
+        refreshLatencyReport();
+        latencyReportTimer.start();
+    }
+    else if (!reportVisible)
+    {
+        latencyReportTimer.stop();
+    }
+}
+
+void JoystickStatusWindow::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    updateLatencyReportTimer();
+}
+
+void JoystickStatusWindow::hideEvent(QHideEvent *event)
+{
+    QDialog::hideEvent(event);
+    updateLatencyReportTimer();
+}
+
+void JoystickStatusWindow::resetLatencyReport()
+{
+    InputLatencyTracer::getInstance()->reset();
+    refreshLatencyReport();
+}
+
+void JoystickStatusWindow::scheduleAxisUpdate(int value)
+{
+    Q_UNUSED(value);
+
+    UiUpdateBus::getInstance()->scheduleUpdate(this);
+}
+
+/**
+ * @brief Sample the current value of every axis once per frame instead of
+ *     updating a progress bar for every axis event.
+ */
+void JoystickStatusWindow::applyFrameUpdate()
+{
+    QHashIterator<JoyAxis*, QProgressBar*> iter(axisBars);
+    while (iter.hasNext())
+    {
+        iter.next();
+        iter.value()->setValue(iter.key()->getCurrentRawValue());
+    }
+}
@@ -2,6 +2,9 @@
 #define JOYSTICKSTATUSWINDOW_H
 
 #include <QDialog>
+#include <QTimer>
+#include <QHash>
+#include <QProgressBar>
 
 #include "inputdevice.h"
 
@@ -18,7 +21,12 @@ public:
     ~JoystickStatusWindow();
 
 protected:
+    virtual void showEvent(QShowEvent *event);
+    virtual void hideEvent(QHideEvent *event);
+
     InputDevice *joystick;
+    QTimer latencyReportTimer;
+    QHash<JoyAxis*, QProgressBar*> axisBars;
 
 private:
     Ui::JoystickStatusWindow *ui;
@@ -26,6 +34,12 @@ private:
 private slots:
     void restoreButtonStates(int code);
     void obliterate();
+    void changeLatencyTracing(bool enabled);
+    void refreshLatencyReport();
+    void resetLatencyReport();
+    void updateLatencyReportTimer();
+    void scheduleAxisUpdate(int value);
+    void applyFrameUpdate();
 };
 
 #endif // JOYSTICKSTATUSWINDOW_H
@@ -520,7 +520,8 @@ void JoyTabWidget::openConfigFileDialog()
 
 /**
  * @brief Create and render all push buttons corresponding to joystick
- *     controls for all sets.
+ *     controls for all sets that have been used. The page of a set that
+ *     does not exist yet is filled when the set is first selected.
  */
 void JoyTabWidget::fillButtons()
 {
@@ -529,8 +530,11 @@ void JoyTabWidget::fillButtons()
 
     for (int i=0; i < Joystick::NUMBER_JOYSETS; i++)
     {
-        SetJoystick *currentSet = joystick->getSetJoystick(i);
-        fillSetButtons(currentSet);
+        SetJoystick *currentSet = joystick->findSetJoystick(i);
+        if (currentSet)
+        {
+            fillSetButtons(currentSet);
+        }
     }
 
     refreshCopySetActions();
@@ -1199,6 +1203,11 @@ void JoyTabWidget::changeCurrentSet(int index)
     }
 
     joystick->setActiveSetNumber(index);
+    if (!displayedSets.contains(index))
+    {
+        fillSetButtons(joystick->getSetJoystick(index));
+    }
+
     stackedWidget_2->setCurrentIndex(index);
 
     switch (index)
@@ -1336,8 +1345,10 @@ void JoyTabWidget::removeCurrentButtons()
 
     for (int i=0; i < Joystick::NUMBER_JOYSETS; i++)
     {
-        SetJoystick *currentSet = joystick->getSetJoystick(i);
-        removeSetButtons(currentSet);
+        if (displayedSets.contains(i))
+        {
+            removeSetButtons(joystick->findSetJoystick(i));
+        }
     }
 }
 
@@ -1409,7 +1420,7 @@ void JoyTabWidget::refreshSetButtons()
     {
         QPushButton *tempSetButton = 0;
         QAction *tempSetAction = 0;
-        SetJoystick *tempSet = joystick->getSetJoystick(i);
+        SetJoystick *tempSet = joystick->findSetJoystick(i);
         switch (i)
         {
             case 0:
@@ -1446,7 +1457,7 @@ void JoyTabWidget::refreshSetButtons()
                 break;
         }
 
-        if (!tempSet->getName().isEmpty())
+        if (tempSet && !tempSet->getName().isEmpty())
         {
             QString tempName = tempSet->getName();
             QString tempNameEscaped = tempName;
@@ -1833,6 +1844,7 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
 
     SetJoystick *currentSet = set;
     currentSet->establishPropertyUpdatedConnection();
+    displayedSets.insert(currentSet->getIndex());
 
     QGridLayout *stickGrid = 0;
     QGroupBox *stickGroup = 0;
@@ -2117,6 +2129,7 @@ void JoyTabWidget::removeSetButtons(SetJoystick *set)
 {
     SetJoystick *currentSet = set;
     currentSet->disconnectPropertyUpdatedConnection();
+    displayedSets.remove(currentSet->getIndex());
 
     QLayoutItem *child = 0;
     QGridLayout *current_layout = 0;
@@ -2291,9 +2304,9 @@ void JoyTabWidget::refreshCopySetActions()
 
     for (int i=0; i < InputDevice::NUMBER_JOYSETS; i++)
     {
-        SetJoystick *tempSet = joystick->getSetJoystick(i);
+        SetJoystick *tempSet = joystick->findSetJoystick(i);
         QAction *newaction = 0;
-        if (!tempSet->getName().isEmpty())
+        if (tempSet && !tempSet->getName().isEmpty())
         {
             QString tempName = tempSet->getName();
             QString tempNameEscaped = tempName;
@@ -10,6 +10,7 @@
 #include <QSpacerItem>
 #include <QFileDialog>
 #include <QHash>
+#include <QSet>
 #include <QStackedWidget>
 #include <QScrollArea>
 #include <QIcon>
@@ -123,6 +124,8 @@ protected:
     int comboBoxIndex;
     bool hideEmptyButtons;
     QString oldProfileName;
+    // Sets whose page currently holds buttons.
+    QSet<int> displayedSets;
 
     static const int DEFAULTNUMBERPROFILES = 5;
 
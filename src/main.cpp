@@ -20,6 +20,7 @@
 #include <QTextStream>
 #include <QLocalSocket>
 #include <QSettings>
+#include <QTimer>
 
 #ifdef Q_OS_WIN
 #include <QStyle>
@@ -58,6 +59,11 @@
 
 #include "antkeymapper.h"
 #include "logger.h"
+#include "inputlatencytracer.h"
+#include "inputtracerecorder.h"
+#include "inputtracereplayer.h"
+#include "mousemotionthread.h"
+#include "uiupdatebus.h"
 
 #ifndef Q_OS_WIN
 static void termSignalTermHandler(int signal)
@@ -532,6 +538,14 @@ int main(int argc, char *argv[])
     }
     else
     {
+#if defined(Q_OS_UNIX) && defined(WITH_UINPUT)
+        if (factory->handler()->getIdentifier() == "uinput")
+        {
+            UInputEventHandler *uinputHandler = static_cast<UInputEventHandler*>(factory->handler());
+            uinputHandler->setSpringAbsoluteStatus(
+                        settings.value("Mouse/SpringAbsolutePointer", false).toBool());
+        }
+#endif
         status = factory->handler()->init();
     }
 
@@ -606,6 +620,69 @@ int main(int argc, char *argv[])
 
     AntKeyMapper::getInstance(eventGeneratorIdentifier);
 
+    if (cmdutility.isLatencyReportRequested())
+    {
+        InputLatencyTracer::setEnabled(true);
+    }
+
+    MouseMotionThread *mouseMotionThread = 0;
+    int motionThreadRate = settings.value("Mouse/MotionThreadRate", 0).toInt();
+    if (motionThreadRate > 0)
+    {
+        if (factory->handler()->hasThreadedMouseSupport())
+        {
+            mouseMotionThread = new MouseMotionThread(factory->handler());
+            mouseMotionThread->setRate(motionThreadRate);
+            mouseMotionThread->start(QThread::TimeCriticalPriority);
+            JoyButton::setMouseMotionThread(mouseMotionThread);
+
+            appLogger.LogInfo(QObject::tr("Moving the cursor from a motion thread at %1 Hz.")
+                              .arg(mouseMotionThread->getRate()), true, true);
+        }
+        else
+        {
+            appLogger.LogInfo(QObject::tr("The %1 event generator does not support a mouse motion thread.")
+                              .arg(factory->handler()->getName()), true, true);
+        }
+    }
+
+    InputTraceRecorder *inputRecorder = 0;
+    if (cmdutility.hasRecordInputLocation())
+    {
+        inputRecorder = new InputTraceRecorder(cmdutility.getRecordInputLocation());
+        if (inputRecorder->start())
+        {
+            joypad_worker->setInputRecorder(inputRecorder);
+        }
+        else
+        {
+            appLogger.LogError(inputRecorder->getErrorString(), true, true);
+            delete inputRecorder;
+            inputRecorder = 0;
+        }
+    }
+
+    InputTraceReplayer *inputReplayer = 0;
+    if (cmdutility.hasReplayInputLocation())
+    {
+        inputReplayer = new InputTraceReplayer(joysticks);
+        inputReplayer->setSpeed(cmdutility.getReplaySpeed());
+        if (inputReplayer->load(cmdutility.getReplayInputLocation()))
+        {
+            appLogger.LogInfo(QObject::tr("Replaying %1 recorded events from %2")
+                              .arg(inputReplayer->getNumberEvents())
+                              .arg(cmdutility.getReplayInputLocation()), true, true);
+            // Start once the event loop is running.
+            QTimer::singleShot(0, inputReplayer, SLOT(start()));
+        }
+        else
+        {
+            appLogger.LogError(inputReplayer->getErrorString(), true, true);
+            delete inputReplayer;
+            inputReplayer = 0;
+        }
+    }
+
     MainWindow *w = new MainWindow(joysticks, &cmdutility, &settings);
 
     FirstRunWizard *runWillard = 0;
@@ -674,6 +751,36 @@ int main(int argc, char *argv[])
 
     appLogger.LogInfo(QObject::tr("Quitting Program"), true, true);
 
+    if (cmdutility.isLatencyReportRequested())
+    {
+        appLogger.LogInfo(InputLatencyTracer::getInstance()->generateReport(), false, true);
+    }
+
+    InputLatencyTracer::setEnabled(false);
+    InputLatencyTracer::getInstance()->deleteInstance();
+    UiUpdateBus::deleteInstance();
+
+    if (mouseMotionThread)
+    {
+        JoyButton::setMouseMotionThread(0);
+        mouseMotionThread->stop();
+        delete mouseMotionThread;
+        mouseMotionThread = 0;
+    }
+
+    if (inputReplayer)
+    {
+        delete inputReplayer;
+        inputReplayer = 0;
+    }
+
+    if (inputRecorder)
+    {
+        joypad_worker->setInputRecorder(0);
+        delete inputRecorder;
+        inputRecorder = 0;
+    }
+
     deleteInputDevices(joysticks);
     delete joysticks;
     joysticks = 0;
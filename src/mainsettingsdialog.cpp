@@ -23,6 +23,7 @@
 #include "addeditautoprofiledialog.h"
 #include "editalldefaultautoprofiledialog.h"
 #include "common.h"
+#include "mousemotionthread.h"
 
 #ifdef Q_OS_WIN
   #include "eventhandlerfactory.h"
@@ -221,6 +222,16 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings, QList<InputD
     ui->disableWindowsEnhancedPointCheckBox->setVisible(false);
 #endif
 
+#if defined(Q_OS_UNIX) && defined(WITH_UINPUT)
+    bool springAbsolutePointer = settings->value("Mouse/SpringAbsolutePointer", false).toBool();
+    if (springAbsolutePointer)
+    {
+        ui->springAbsolutePointerCheckBox->setChecked(true);
+    }
+#else
+    ui->springAbsolutePointerCheckBox->setVisible(false);
+#endif
+
     bool smoothingEnabled = settings->value("Mouse/Smoothing", false).toBool();
     if (smoothingEnabled)
     {
@@ -261,6 +272,24 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings, QList<InputD
     ui->mouseRefreshRateComboBox->setToolTip(tempTooltip);
 #endif
 
+#if defined(Q_OS_UNIX) && defined(WITH_UINPUT)
+    ui->motionThreadRateComboBox->addItem(tr("Disabled"), 0);
+    for (int i = MouseMotionThread::MINRATE; i <= MouseMotionThread::MAXRATE; i *= 2)
+    {
+        ui->motionThreadRateComboBox->addItem(QString("%1 Hz").arg(i), i);
+    }
+
+    int motionThreadRate = settings->value("Mouse/MotionThreadRate", 0).toInt();
+    int motionThreadIndex = ui->motionThreadRateComboBox->findData(motionThreadRate);
+    if (motionThreadIndex >= 0)
+    {
+        ui->motionThreadRateComboBox->setCurrentIndex(motionThreadIndex);
+    }
+#else
+    ui->motionThreadRateLabel->setVisible(false);
+    ui->motionThreadRateComboBox->setVisible(false);
+#endif
+
     fillSpringScreenPresets();
     //ui->springGroupBox->setVisible(false);
 
@@ -649,6 +678,15 @@ void MainSettingsDialog::saveNewSettings()
     JoyButton::setSpringModeScreen(springScreen);
     settings->setValue("Mouse/SpringScreen", QString::number(springScreen));
 
+#if defined(Q_OS_UNIX) && defined(WITH_UINPUT)
+    bool springAbsolutePointer = ui->springAbsolutePointerCheckBox->isChecked();
+    settings->setValue("Mouse/SpringAbsolutePointer", springAbsolutePointer ? "1" : "0");
+
+    int motionThreadIndex = ui->motionThreadRateComboBox->currentIndex();
+    int motionThreadRate = ui->motionThreadRateComboBox->itemData(motionThreadIndex).toInt();
+    settings->setValue("Mouse/MotionThreadRate", motionThreadRate);
+#endif
+
     settings->sync();
 }
 
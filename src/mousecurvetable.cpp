@@ -0,0 +1,80 @@
+//#include <QDebug>
+
+#include "mousecurvetable.h"
+
+const int MouseCurveTable::TABLESIZE;
+
+MouseCurveTable::MouseCurveTable()
+{
+}
+
+/**
+ * @brief Set the curve value for a sample.
+ * @param Sample index in the range of 0 - TABLESIZE
+ * @param Curve value at the distance for that sample
+ */
+void MouseCurveTable::setValue(int index, double value)
+{
+    if (values.isEmpty())
+    {
+        values.fill(0.0, TABLESIZE + 1);
+    }
+
+    if (index >= 0 && index <= TABLESIZE)
+    {
+        values[index] = value;
+    }
+}
+
+/**
+ * @brief Evaluate the curve at a distance.
+ * @param Distance in the range of 0.0 - 1.0. Values outside of the range
+ *     are clamped.
+ * @return Interpolated curve value
+ */
+double MouseCurveTable::lookup(double distance) const
+{
+    double result = 0.0;
+
+    if (!values.isEmpty())
+    {
+        if (distance <= 0.0)
+        {
+            result = values.at(0);
+        }
+        else if (distance >= 1.0)
+        {
+            result = values.at(TABLESIZE);
+        }
+        else
+        {
+            double position = distance * TABLESIZE;
+            int index = static_cast<int>(position);
+            double fraction = position - index;
+            double lower = values.at(index);
+            result = lower + ((values.at(index + 1) - lower) * fraction);
+        }
+    }
+
+    return result;
+}
+
+bool MouseCurveTable::isEmpty() const
+{
+    return values.isEmpty();
+}
+
+void MouseCurveTable::clear()
+{
+    values.clear();
+}
+
+/**
+ * @brief Get the distance that a sample represents.
+ * @param Sample index in the range of 0 - TABLESIZE
+ * @return Distance in the range of 0.0 - 1.0
+ */
+double MouseCurveTable::getDistanceForIndex(int index)
+{
+    return index / static_cast<double>(TABLESIZE);
+}
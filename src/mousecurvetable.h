@@ -0,0 +1,31 @@
+#ifndef MOUSECURVETABLE_H
+#define MOUSECURVETABLE_H
+
+#include <QVector>
+
+/**
+ * @brief Response curve sampled at evenly spaced distances between 0.0 and
+ *     1.0. Values between samples are linearly interpolated so evaluating a
+ *     curve on a mouse tick costs the same for every curve type. Tables are
+ *     implicitly shared and can be copied cheaply between buttons.
+ */
+class MouseCurveTable
+{
+public:
+    explicit MouseCurveTable();
+
+    void setValue(int index, double value);
+    double lookup(double distance) const;
+    bool isEmpty() const;
+    void clear();
+
+    static double getDistanceForIndex(int index);
+
+    // Number of intervals in the table. Table holds one more sample.
+    static const int TABLESIZE = 1000;
+
+protected:
+    QVector<double> values;
+};
+
+#endif // MOUSECURVETABLE_H
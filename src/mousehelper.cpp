@@ -8,6 +8,8 @@ MouseHelper::MouseHelper(QObject *parent) :
     previousCursorLocation[1] = 0;
     pivotPoint[0] = -1;
     pivotPoint[1] = -1;
+    springCursorLocation[0] = -1;
+    springCursorLocation[1] = -1;
     mouseTimer.setSingleShot(true);
     QObject::connect(&mouseTimer, SIGNAL(timeout()), this, SLOT(resetSpringMouseMoving()));
 }
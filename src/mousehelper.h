@@ -13,6 +13,8 @@ public:
     bool springMouseMoving;
     int previousCursorLocation[2];
     int pivotPoint[2];
+    // Last position set through an absolute pointer device.
+    int springCursorLocation[2];
     QTimer mouseTimer;
     
 signals:
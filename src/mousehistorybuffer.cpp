@@ -0,0 +1,143 @@
+//#include <QDebug>
+
+#include "mousehistorybuffer.h"
+
+const int MouseHistoryBuffer::MAXSIZE;
+
+MouseHistoryBuffer::MouseHistoryBuffer()
+{
+    size = 1;
+    weight = 0.0;
+    clear();
+}
+
+/**
+ * @brief Change the number of samples kept. Existing samples are dropped.
+ * @param Number of samples. Clamped to the range 1 - MAXSIZE.
+ */
+void MouseHistoryBuffer::setSize(int size)
+{
+    if (size < 1)
+    {
+        size = 1;
+    }
+    else if (size > MAXSIZE)
+    {
+        size = MAXSIZE;
+    }
+
+    this->size = size;
+    clear();
+}
+
+int MouseHistoryBuffer::getSize()
+{
+    return size;
+}
+
+int MouseHistoryBuffer::getCount()
+{
+    return count;
+}
+
+void MouseHistoryBuffer::clear()
+{
+    count = 0;
+    newest = size - 1;
+    updatesSinceRecalculate = 0;
+    weightedSum = 0.0;
+    totalWeight = 0.0;
+    nextWeight = 1.0;
+    evictWeight = 0.0;
+}
+
+/**
+ * @brief Fill the entire history with the same sample.
+ * @param Sample value
+ * @param Weight modifier to use for the history
+ */
+void MouseHistoryBuffer::fill(double value, double weight)
+{
+    for (int i=0; i < size; i++)
+    {
+        samples[i] = value;
+    }
+
+    count = size;
+    newest = size - 1;
+    this->weight = weight;
+    recalculate();
+}
+
+/**
+ * @brief Add a new sample to the history. The oldest sample is removed
+ *     once the history is full.
+ * @param Sample value
+ * @param Weight modifier to use for the history
+ */
+void MouseHistoryBuffer::add(double value, double weight)
+{
+    int next = (newest + 1) % size;
+
+    if (count == size)
+    {
+        weightedSum = value + (weightedSum * this->weight) -
+                      (samples[next] * evictWeight);
+    }
+    else
+    {
+        weightedSum = value + (weightedSum * this->weight);
+        totalWeight += nextWeight;
+        nextWeight *= this->weight;
+        count++;
+    }
+
+    samples[next] = value;
+    newest = next;
+    updatesSinceRecalculate++;
+
+    // Rebuild the sums from the samples when the weight modifier has
+    // changed and once per pass through the ring to discard accumulated
+    // rounding error.
+    if (weight != this->weight || updatesSinceRecalculate >= size)
+    {
+        this->weight = weight;
+        recalculate();
+    }
+}
+
+double MouseHistoryBuffer::getWeightedSum()
+{
+    return weightedSum;
+}
+
+double MouseHistoryBuffer::getTotalWeight()
+{
+    return totalWeight;
+}
+
+void MouseHistoryBuffer::recalculate()
+{
+    double currentWeight = 1.0;
+    weightedSum = 0.0;
+    totalWeight = 0.0;
+
+    int index = newest;
+    for (int i=0; i < count; i++)
+    {
+        weightedSum += samples[index] * currentWeight;
+        totalWeight += currentWeight;
+        currentWeight *= weight;
+        index = (index > 0) ? index - 1 : size - 1;
+    }
+
+    nextWeight = currentWeight;
+
+    evictWeight = 1.0;
+    for (int i=0; i < size; i++)
+    {
+        evictWeight *= weight;
+    }
+
+    updatesSinceRecalculate = 0;
+}
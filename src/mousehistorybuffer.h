@@ -0,0 +1,47 @@
+#ifndef MOUSEHISTORYBUFFER_H
+#define MOUSEHISTORYBUFFER_H
+
+/**
+ * @brief Fixed capacity history of cursor movement samples used for mouse
+ *     smoothing. Samples are kept in a ring and the exponentially weighted
+ *     sum over the history is updated as samples are added so each mouse
+ *     tick costs the same regardless of the history size. The newest
+ *     sample has a weight of 1 and each older sample is multiplied by the
+ *     weight modifier once more.
+ */
+class MouseHistoryBuffer
+{
+public:
+    explicit MouseHistoryBuffer();
+
+    void setSize(int size);
+    int getSize();
+    int getCount();
+    void clear();
+    void fill(double value, double weight);
+    void add(double value, double weight);
+    double getWeightedSum();
+    double getTotalWeight();
+
+    static const int MAXSIZE = 100;
+
+protected:
+    void recalculate();
+
+    double samples[MAXSIZE];
+    int size;
+    int count;
+    // Index of the newest sample.
+    int newest;
+    int updatesSinceRecalculate;
+
+    double weight;
+    double weightedSum;
+    double totalWeight;
+    // weight ^ count. Weight given to the next sample that grows the history.
+    double nextWeight;
+    // weight ^ size. Weight of a sample once it falls out of the history.
+    double evictWeight;
+};
+
+#endif // MOUSEHISTORYBUFFER_H
@@ -0,0 +1,188 @@
+//#include <QDebug>
+#include <QMutexLocker>
+
+#ifdef Q_OS_LINUX
+#include <time.h>
+#endif
+
+#include "mousemotionthread.h"
+#include "eventhandlers/baseeventhandler.h"
+
+const int MouseMotionThread::MINRATE = 250;
+const int MouseMotionThread::MAXRATE = 1000;
+const int MouseMotionThread::DEFAULTRATE = 500;
+const int MouseMotionThread::STALEVELOCITYTIMEOUT = 100;
+
+MouseMotionThread::MouseMotionThread(BaseEventHandler *handler, QObject *parent) :
+    QThread(parent)
+{
+    this->handler = handler;
+    rate.fetchAndStoreOrdered(DEFAULTRATE);
+    xVelocity = 0.0;
+    yVelocity = 0.0;
+    velocityTimestamp = 0;
+    velocityGeneration = 0;
+
+    clock.start();
+}
+
+MouseMotionThread::~MouseMotionThread()
+{
+    stop();
+}
+
+/**
+ * @brief Set the number of cursor updates per second.
+ * @param Rate in Hz. Clamped to the range MINRATE - MAXRATE.
+ */
+void MouseMotionThread::setRate(int rate)
+{
+    this->rate.fetchAndStoreOrdered(qBound(MINRATE, rate, MAXRATE));
+}
+
+int MouseMotionThread::getRate()
+{
+    return rate.fetchAndAddOrdered(0);
+}
+
+/**
+ * @brief Publish the current cursor velocity. Called from the GUI thread
+ *     on every mouse event tick.
+ * @param Horizontal velocity in pixels per second
+ * @param Vertical velocity in pixels per second
+ */
+void MouseMotionThread::setVelocity(double xVelocity, double yVelocity)
+{
+    QMutexLocker locker(&velocityMutex);
+    this->xVelocity = xVelocity;
+    this->yVelocity = yVelocity;
+    velocityTimestamp = clock.nsecsElapsed();
+
+    if (xVelocity != 0.0 || yVelocity != 0.0)
+    {
+        velocityGeneration++;
+        velocityChanged.wakeAll();
+    }
+}
+
+void MouseMotionThread::clearVelocity()
+{
+    setVelocity(0.0, 0.0);
+}
+
+/**
+ * @brief Ask the thread to finish and wait for it to exit. The thread
+ *     checks the request once per tick and is woken up if it is idle.
+ */
+void MouseMotionThread::stop()
+{
+    stopRequested.fetchAndStoreOrdered(1);
+
+    velocityMutex.lock();
+    velocityChanged.wakeAll();
+    velocityMutex.unlock();
+
+    wait();
+}
+
+void MouseMotionThread::run()
+{
+    double remainderX = 0.0;
+    double remainderY = 0.0;
+    qint64 lastTick = clock.nsecsElapsed();
+    qint64 deadline = lastTick;
+
+    while (stopRequested.fetchAndAddOrdered(0) == 0)
+    {
+        waitForNextTick(deadline);
+
+        // Integrate over the time that actually passed rather than
+        // the nominal tick interval.
+        qint64 now = clock.nsecsElapsed();
+        qint64 elapsed = now - lastTick;
+        lastTick = now;
+
+        double currentX = 0.0;
+        double currentY = 0.0;
+        qint64 timestamp = 0;
+        unsigned int generation = 0;
+
+        velocityMutex.lock();
+        currentX = xVelocity;
+        currentY = yVelocity;
+        timestamp = velocityTimestamp;
+        generation = velocityGeneration;
+        velocityMutex.unlock();
+
+        if ((now - timestamp) > (STALEVELOCITYTIMEOUT * Q_INT64_C(1000000)))
+        {
+            currentX = 0.0;
+            currentY = 0.0;
+        }
+
+        if (currentX == 0.0 && currentY == 0.0)
+        {
+            remainderX = 0.0;
+            remainderY = 0.0;
+
+            // Nothing to move. Sleep until the GUI thread publishes a
+            // new velocity instead of waking up every tick.
+            velocityMutex.lock();
+            while (velocityGeneration == generation &&
+                   stopRequested.fetchAndAddOrdered(0) == 0)
+            {
+                velocityChanged.wait(&velocityMutex);
+            }
+            velocityMutex.unlock();
+
+            lastTick = clock.nsecsElapsed();
+            deadline = lastTick;
+        }
+        else
+        {
+            double distanceX = (currentX * elapsed * 0.000000001) + remainderX;
+            double distanceY = (currentY * elapsed * 0.000000001) + remainderY;
+
+            // Truncate towards zero and carry the fraction over
+            // to the next tick.
+            int moveX = static_cast<int>(distanceX);
+            int moveY = static_cast<int>(distanceY);
+            remainderX = distanceX - moveX;
+            remainderY = distanceY - moveY;
+
+            if (moveX != 0 || moveY != 0)
+            {
+                handler->sendThreadedMouseEvent(moveX, moveY);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sleep until the next tick deadline. The deadline advances by the
+ *     tick interval so timing errors do not accumulate. A deadline that has
+ *     already passed is moved forward from the current time.
+ * @param Deadline of the previous tick in nanoseconds
+ */
+void MouseMotionThread::waitForNextTick(qint64 &deadline)
+{
+    qint64 interval = Q_INT64_C(1000000000) / getRate();
+    qint64 now = clock.nsecsElapsed();
+
+    deadline += interval;
+    if (deadline <= now)
+    {
+        deadline = now + interval;
+    }
+
+    qint64 remaining = deadline - now;
+
+#ifdef Q_OS_LINUX
+    struct timespec sleepTime;
+    sleepTime.tv_sec = remaining / Q_INT64_C(1000000000);
+    sleepTime.tv_nsec = remaining % Q_INT64_C(1000000000);
+    clock_nanosleep(CLOCK_MONOTONIC, 0, &sleepTime, 0);
+#else
+    QThread::usleep(static_cast<unsigned long>(remaining / 1000));
+#endif
+}
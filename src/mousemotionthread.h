@@ -0,0 +1,66 @@
+#ifndef MOUSEMOTIONTHREAD_H
+#define MOUSEMOTIONTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+class BaseEventHandler;
+
+/**
+ * @brief Thread that moves the cursor at a fixed rate independent of the
+ *     Qt event loop. The GUI thread publishes the smoothed cursor velocity
+ *     computed from the active mouse slots. The thread integrates that
+ *     velocity over the elapsed time it measures on every tick and writes
+ *     relative movement through the event handler. Cursor motion therefore
+ *     keeps going if the GUI thread is briefly stalled. A velocity that has
+ *     not been refreshed for STALEVELOCITYTIMEOUT ms is treated as zero.
+ *     The thread sleeps without waking up while the velocity is zero.
+ */
+class MouseMotionThread : public QThread
+{
+    Q_OBJECT
+public:
+    explicit MouseMotionThread(BaseEventHandler *handler, QObject *parent = 0);
+    ~MouseMotionThread();
+
+    void setRate(int rate);
+    int getRate();
+    void setVelocity(double xVelocity, double yVelocity);
+    void clearVelocity();
+    void stop();
+
+    static const int MINRATE;
+    static const int MAXRATE;
+    static const int DEFAULTRATE;
+    static const int STALEVELOCITYTIMEOUT;
+
+protected:
+    virtual void run();
+    void waitForNextTick(qint64 &deadline);
+
+    BaseEventHandler *handler;
+    QAtomicInt rate;
+    QAtomicInt stopRequested;
+
+    // Guards the published velocity.
+    QMutex velocityMutex;
+    QWaitCondition velocityChanged;
+    double xVelocity;
+    double yVelocity;
+    qint64 velocityTimestamp;
+    // Incremented whenever a non-zero velocity is published.
+    unsigned int velocityGeneration;
+
+    // Shared clock. QElapsedTimer is monotonic and read only after start.
+    QElapsedTimer clock;
+
+signals:
+
+public slots:
+
+};
+
+#endif // MOUSEMOTIONTHREAD_H
@@ -226,6 +226,10 @@ void MouseSettingsDialog::updateAccelerationCurvePresetComboBox(JoyButton::JoyMo
     {
         ui->accelerationComboBox->setCurrentIndex(8);
     }
+    else if (mouseCurve == JoyButton::CustomCurve)
+    {
+        ui->accelerationComboBox->setCurrentIndex(9);
+    }
 }
 
 JoyButton::JoyMouseCurve MouseSettingsDialog::getMouseCurveForIndex(int index)
@@ -264,6 +268,10 @@ JoyButton::JoyMouseCurve MouseSettingsDialog::getMouseCurveForIndex(int index)
     {
         temp = JoyButton::EasingCubicCurve;
     }
+    else if (index == 9)
+    {
+        temp = JoyButton::CustomCurve;
+    }
 
     return temp;
 }
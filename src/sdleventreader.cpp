@@ -11,6 +11,7 @@ SDLEventReader::SDLEventReader(QMap<SDL_JoystickID, InputDevice *> *joysticks, A
 {
     this->joysticks = joysticks;
     this->settings = settings;
+    this->eventDrainEnabled = false;
     initSDL();
 }
 
@@ -89,11 +90,96 @@ void SDLEventReader::performWork()
         int status = SDL_WaitEvent(NULL);
         if (status)
         {
-            emit eventRaised();
+            if (eventDrainEnabled)
+            {
+                drainEvents();
+            }
+            else
+            {
+                emit eventRaised();
+            }
         }
     }
 }
 
+/**
+ * @brief Pull every pending SDL event into a lock-free ring buffer while
+ *     still on the reader thread. The GUI thread is only notified when it
+ *     has no wakeup pending so a burst of events costs a single cross
+ *     thread wakeup. The reader re-arms itself instead of waiting for the
+ *     GUI thread to reschedule it.
+ */
+void SDLEventReader::drainEvents()
+{
+    SDL_Event event;
+    bool quitFound = false;
+
+    // Events that do not fit stay in the SDL queue until the GUI
+    // thread catches up.
+    while (!drainedEvents.isFull() && SDL_PollEvent(&event) > 0)
+    {
+        if (event.type == SDL_QUIT)
+        {
+            quitFound = true;
+        }
+
+        drainedEvents.enqueue(event);
+    }
+
+    bool notify = !drainedEvents.isEmpty() && drainNotifyPending.testAndSetOrdered(0, 1);
+    if (notify || quitFound)
+    {
+        emit eventRaised();
+    }
+
+    if (drainedEvents.isFull())
+    {
+        // Avoid spinning on SDL_WaitEvent while the buffer is full.
+        SDL_Delay(1);
+    }
+
+    if (!quitFound && sdlIsOpen)
+    {
+        // Go through the thread event loop so queued stop and refresh
+        // requests still get a chance to run.
+        QMetaObject::invokeMethod(this, "performWork", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief Hand all events gathered by the reader thread over to the caller.
+ *     Must only be called from the thread that receives eventRaised.
+ * @param Queue that will receive the buffered events
+ */
+void SDLEventReader::takeDrainedEvents(QQueue<SDL_Event> *events)
+{
+    // Clear the flag first so events added while draining raise
+    // another notification.
+    drainNotifyPending.fetchAndStoreOrdered(0);
+
+    SDL_Event event;
+    while (drainedEvents.dequeue(&event))
+    {
+        events->enqueue(event);
+    }
+}
+
+/**
+ * @brief Set whether the reader thread should empty the SDL event queue
+ *     itself rather than leaving polling to the GUI thread.
+ *     Must be set before the reader thread is started.
+ * @param Drain status
+ */
+void SDLEventReader::setEventDrainStatus(bool enabled)
+{
+    eventDrainEnabled = enabled;
+}
+
+bool SDLEventReader::isEventDrainEnabled()
+{
+    return eventDrainEnabled;
+}
+
 void SDLEventReader::stop()
 {
     if (sdlIsOpen)
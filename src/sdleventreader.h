@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QMap>
+#include <QQueue>
+#include <QAtomicInt>
 
 #ifdef USE_SDL_2
 #include <SDL2/SDL.h>
@@ -13,6 +15,7 @@
 #include "joystick.h"
 #include "inputdevice.h"
 #include "antimicrosettings.h"
+#include "spscringbuffer.h"
 
 class SDLEventReader : public QObject
 {
@@ -23,14 +26,23 @@ public:
 
     bool isSDLOpen();
 
+    void setEventDrainStatus(bool enabled);
+    bool isEventDrainEnabled();
+    void takeDrainedEvents(QQueue<SDL_Event> *events);
+
 protected:
     void initSDL();
     void closeSDL();
     void clearEvents();
+    void drainEvents();
 
     QMap<SDL_JoystickID, InputDevice*> *joysticks;
     bool sdlIsOpen;
     AntiMicroSettings *settings;
+    bool eventDrainEnabled;
+    // Events handed from the reader thread to the GUI thread.
+    SPSCRingBuffer<SDL_Event, 1024> drainedEvents;
+    QAtomicInt drainNotifyPending;
 
 signals:
     void eventRaised();
@@ -1,4 +1,5 @@
 //#include <QDebug>
+#include <typeinfo>
 #include <QHashIterator>
 
 #include "setjoystick.h"
@@ -288,6 +289,44 @@ void SetJoystick::release()
     }
 }
 
+/**
+ * @brief Release the elements of the set that are not in their neutral
+ *     state. Leaves the set in the same state as release() without running
+ *     events for elements that are already released.
+ */
+void SetJoystick::releaseActive()
+{
+    QHashIterator<int, JoyButton*> iter(buttons);
+    while (iter.hasNext())
+    {
+        JoyButton *button = iter.next().value();
+        if (!button->isNeutral())
+        {
+            button->joyEvent(false, true);
+        }
+    }
+
+    QHashIterator<int, JoyAxis*> iter2(axes);
+    while (iter2.hasNext())
+    {
+        JoyAxis *axis = iter2.next().value();
+        if (!axis->isNeutral())
+        {
+            axis->joyEvent(axis->getCurrentThrottledDeadValue(), true);
+        }
+    }
+
+    QHashIterator<int, JoyDPad*> iter3(hats);
+    while (iter3.hasNext())
+    {
+        JoyDPad *dpad = iter3.next().value();
+        if (!dpad->isNeutral())
+        {
+            dpad->joyEvent(0, true);
+        }
+    }
+}
+
 void SetJoystick::readConfig(QXmlStreamReader *xml)
 {
     if (xml->isStartElement() && xml->name() == "set")
@@ -987,6 +1026,149 @@ void SetJoystick::copyAssignments(SetJoystick *destSet)
     }
 }
 
+/**
+ * @brief Copy the device wide structure of this set to a newly created set.
+ *     Control sticks, virtual dpads, element names and axis throttles are
+ *     shared by all sets of a device. Slot assignments are not copied.
+ * @param Set that will receive the structure
+ */
+void SetJoystick::copyStructure(SetJoystick *destSet)
+{
+    QHashIterator<int, JoyAxis*> axisIter(axes);
+    while (axisIter.hasNext())
+    {
+        JoyAxis *sourceAxis = axisIter.next().value();
+        JoyAxis *destAxis = destSet->axes.value(sourceAxis->getIndex());
+        if (destAxis)
+        {
+            destAxis->setThrottle(sourceAxis->getThrottle());
+            destAxis->setAxisName(sourceAxis->getAxisName());
+            destAxis->getNAxisButton()->setButtonName(sourceAxis->getNAxisButton()->getButtonName());
+            destAxis->getPAxisButton()->setButtonName(sourceAxis->getPAxisButton()->getButtonName());
+        }
+    }
+
+    QHashIterator<int, JoyButton*> buttonIter(buttons);
+    while (buttonIter.hasNext())
+    {
+        buttonIter.next();
+        JoyButton *destButton = destSet->buttons.value(buttonIter.key());
+        if (destButton)
+        {
+            destButton->setButtonName(buttonIter.value()->getButtonName());
+        }
+    }
+
+    QHashIterator<int, JoyDPad*> dpadIter(hats);
+    while (dpadIter.hasNext())
+    {
+        dpadIter.next();
+        JoyDPad *destDPad = destSet->hats.value(dpadIter.key());
+        if (destDPad)
+        {
+            copyDPadNames(dpadIter.value(), destDPad);
+        }
+    }
+
+    QHashIterator<int, JoyControlStick*> stickIter(sticks);
+    while (stickIter.hasNext())
+    {
+        stickIter.next();
+        int index = stickIter.key();
+        JoyControlStick *sourceStick = stickIter.value();
+        JoyControlStick *destStick = destSet->sticks.value(index);
+        if (!destStick)
+        {
+            JoyAxis *axisX = destSet->getJoyAxis(sourceStick->getAxisX()->getIndex());
+            JoyAxis *axisY = destSet->getJoyAxis(sourceStick->getAxisY()->getIndex());
+            if (axisX && axisY)
+            {
+                destStick = new JoyControlStick(axisX, axisY, index, destSet->getIndex(), device);
+                destSet->addControlStick(index, destStick);
+            }
+        }
+
+        if (destStick)
+        {
+            destStick->setStickName(sourceStick->getStickName());
+
+            QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton*> iter(*sourceStick->getButtons());
+            while (iter.hasNext())
+            {
+                iter.next();
+                JoyControlStickButton *destButton = destStick->getDirectionButton(iter.key());
+                if (destButton)
+                {
+                    destButton->setButtonName(iter.value()->getButtonName());
+                }
+            }
+        }
+    }
+
+    QHashIterator<int, VDPad*> vdpadIter(vdpads);
+    while (vdpadIter.hasNext())
+    {
+        vdpadIter.next();
+        int index = vdpadIter.key();
+        VDPad *sourceVDPad = vdpadIter.value();
+        VDPad *destVDPad = destSet->vdpads.value(index);
+        if (!destVDPad)
+        {
+            destVDPad = new VDPad(index, destSet->getIndex(), destSet);
+
+            JoyDPadButton::JoyDPadDirections directions[4] = {
+                JoyDPadButton::DpadUp, JoyDPadButton::DpadDown,
+                JoyDPadButton::DpadLeft, JoyDPadButton::DpadRight
+            };
+
+            for (int i=0; i < 4; i++)
+            {
+                JoyButton *sourceButton = sourceVDPad->getVButton(directions[i]);
+                JoyButton *destButton = 0;
+                if (sourceButton && typeid(*sourceButton) == typeid(JoyAxisButton))
+                {
+                    JoyAxisButton *axisButton = static_cast<JoyAxisButton*>(sourceButton);
+                    JoyAxis *destAxis = destSet->getJoyAxis(axisButton->getAxis()->getIndex());
+                    if (destAxis)
+                    {
+                        destButton = axisButton->getJoyNumber() == 0 ?
+                                    destAxis->getNAxisButton() : destAxis->getPAxisButton();
+                    }
+                }
+                else if (sourceButton)
+                {
+                    destButton = destSet->getJoyButton(sourceButton->getJoyNumber());
+                }
+
+                if (destButton)
+                {
+                    destVDPad->addVButton(directions[i], destButton);
+                }
+            }
+
+            destSet->addVDPad(index, destVDPad);
+        }
+
+        copyDPadNames(sourceVDPad, destVDPad);
+    }
+}
+
+void SetJoystick::copyDPadNames(JoyDPad *sourceDPad, JoyDPad *destDPad)
+{
+    destDPad->setDPadName(sourceDPad->getDpadName());
+
+    QHashIterator<int, JoyDPadButton*> iter(*sourceDPad->getButtons());
+    while (iter.hasNext())
+    {
+        iter.next();
+        JoyDPadButton *destButton = destDPad->getJoyButton(iter.key());
+        if (destButton)
+        {
+            destButton->setButtonName(iter.value()->getButtonName());
+        }
+    }
+}
+
 QString SetJoystick::getSetLabel()
 {
     QString temp;
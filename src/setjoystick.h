@@ -42,6 +42,7 @@ public:
     virtual void refreshAxes();
     virtual void refreshHats();
     void release();
+    void releaseActive();
     void addControlStick(int index, JoyControlStick *stick);
     void removeControlStick(int index);
     void addVDPad(int index, VDPad *vdpad);
@@ -55,6 +56,7 @@ public:
     QString getSetLabel();
 
     void copyAssignments(SetJoystick *destSet);
+    void copyStructure(SetJoystick *destSet);
     void raiseAxesDeadZones(int deadZone=0);
     void currentAxesDeadZones(QList<int> *axesDeadZones);
     void setAxesDeadZones(QList<int> *axesDeadZones);
@@ -73,6 +75,7 @@ protected:
     void deleteHats();
     void deleteSticks();
     void deleteVDpads();
+    void copyDPadNames(JoyDPad *sourceDPad, JoyDPad *destDPad);
 
     void enableButtonConnections(JoyButton *button);
     void enableAxisConnections(JoyAxis *axis);
@@ -15,7 +15,8 @@ SetNamesDialog::SetNamesDialog(InputDevice *device, QWidget *parent) :
 
     for (int i=0; i < InputDevice::NUMBER_JOYSETS; i++)
     {
-        QString tempSetName = device->getSetJoystick(i)->getName();
+        SetJoystick *tempSet = device->findSetJoystick(i);
+        QString tempSetName = tempSet ? tempSet->getName() : QString();
         ui->setNamesTableWidget->setItem(i, 0, new QTableWidgetItem(tempSetName));
     }
 
@@ -33,7 +34,8 @@ void SetNamesDialog::saveSetNameChanges()
     {
         QTableWidgetItem *setNameItem = ui->setNamesTableWidget->item(i, 0);
         QString setNameText = setNameItem->text();
-        QString oldSetNameText = device->getSetJoystick(i)->getName();
+        SetJoystick *tempSet = device->findSetJoystick(i);
+        QString oldSetNameText = tempSet ? tempSet->getName() : QString();
         if (setNameText != oldSetNameText)
         {
             device->getSetJoystick(i)->setName(setNameText);
@@ -0,0 +1,105 @@
+#ifndef SPSCRINGBUFFER_H
+#define SPSCRINGBUFFER_H
+
+#include <QtGlobal>
+#include <QAtomicInt>
+
+/**
+ * @brief Fixed size ring buffer shared by exactly one producer thread and
+ *     one consumer thread. Neither side takes a lock. The producer only
+ *     writes the write index and the consumer only writes the read index.
+ *     Size must be a power of two. One slot is kept free to tell a full
+ *     buffer apart from an empty one.
+ */
+template <typename T, int Size>
+class SPSCRingBuffer
+{
+public:
+    SPSCRingBuffer() :
+        readIndex(0),
+        writeIndex(0)
+    {
+    }
+
+    /**
+     * @brief Add an element to the buffer. Producer thread only.
+     * @param Element to add
+     * @return Whether the element was added. False if the buffer is full.
+     */
+    bool enqueue(const T &value)
+    {
+        int current = loadAcquire(writeIndex);
+        int next = (current + 1) & (Size - 1);
+        if (next == loadAcquire(readIndex))
+        {
+            return false;
+        }
+
+        buffer[current] = value;
+        storeRelease(writeIndex, next);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element from the buffer. Consumer thread only.
+     * @param Storage for the removed element
+     * @return Whether an element was available
+     */
+    bool dequeue(T *value)
+    {
+        int current = loadAcquire(readIndex);
+        if (current == loadAcquire(writeIndex))
+        {
+            return false;
+        }
+
+        *value = buffer[current];
+        storeRelease(readIndex, (current + 1) & (Size - 1));
+        return true;
+    }
+
+    bool isEmpty()
+    {
+        return loadAcquire(readIndex) == loadAcquire(writeIndex);
+    }
+
+    bool isFull()
+    {
+        return ((loadAcquire(writeIndex) + 1) & (Size - 1)) == loadAcquire(readIndex);
+    }
+
+    int capacity()
+    {
+        return Size - 1;
+    }
+
+protected:
+    inline static int loadAcquire(QAtomicInt &value)
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        return value.loadAcquire();
+#else
+        return value.fetchAndAddAcquire(0);
+#endif
+    }
+
+    inline static void storeRelease(QAtomicInt &value, int newValue)
+    {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
+        value.storeRelease(newValue);
+#else
+        value.fetchAndStoreRelease(newValue);
+#endif
+    }
+
+    T buffer[Size];
+
+    // Keep the indices on separate cache lines so the two threads do not
+    // invalidate each other on every update.
+    QAtomicInt readIndex;
+    char readPadding[64 - sizeof(QAtomicInt)];
+    QAtomicInt writeIndex;
+    char writePadding[64 - sizeof(QAtomicInt)];
+};
+
+#endif // SPSCRINGBUFFER_H
@@ -0,0 +1,132 @@
+//#include <QDebug>
+#include <QMetaObject>
+
+#include "uiupdatebus.h"
+
+UiUpdateBus* UiUpdateBus::_instance = 0;
+
+// Roughly 60 frames per second.
+const int UiUpdateBus::FRAMEINTERVAL = 16;
+
+UiUpdateBus::UiUpdateBus(QObject *parent) :
+    QObject(parent)
+{
+    frameTimer.setSingleShot(true);
+    frameTimer.setInterval(FRAMEINTERVAL);
+    connect(&frameTimer, SIGNAL(timeout()), this, SLOT(flush()));
+}
+
+UiUpdateBus* UiUpdateBus::getInstance()
+{
+    if (!_instance)
+    {
+        _instance = new UiUpdateBus();
+    }
+
+    return _instance;
+}
+
+void UiUpdateBus::deleteInstance()
+{
+    if (_instance)
+    {
+        delete _instance;
+        _instance = 0;
+    }
+}
+
+/**
+ * @brief Request a call of the applyFrameUpdate() slot of an object on the
+ *     next frame. Repeated requests within a frame result in a single call.
+ *     The timer only runs while updates are pending.
+ * @param Object that implements an applyFrameUpdate() slot
+ */
+void UiUpdateBus::scheduleUpdate(QObject *receiver)
+{
+    if (receiver && !pendingLookup.contains(receiver))
+    {
+        pendingLookup.insert(receiver);
+        pendingReceivers.append(receiver);
+        connect(receiver, SIGNAL(destroyed(QObject*)), this,
+                SLOT(removeReceiver(QObject*)), Qt::UniqueConnection);
+
+        if (!frameTimer.isActive())
+        {
+            frameTimer.start();
+        }
+    }
+}
+
+void UiUpdateBus::flush()
+{
+    // Receivers may schedule themselves again for the next frame
+    // while being updated.
+    flushingReceivers = pendingReceivers;
+    pendingReceivers.clear();
+    pendingLookup.clear();
+
+    while (!flushingReceivers.isEmpty())
+    {
+        QObject *receiver = flushingReceivers.takeFirst();
+        QMetaObject::invokeMethod(receiver, "applyFrameUpdate", Qt::DirectConnection);
+    }
+}
+
+/**
+ * @brief Forget an object that is destroyed. The destroyed signal stays
+ *     connected for the lifetime of a receiver.
+ * @param Object being destroyed
+ */
+void UiUpdateBus::removeReceiver(QObject *receiver)
+{
+    if (pendingLookup.contains(receiver))
+    {
+        pendingLookup.remove(receiver);
+        pendingReceivers.removeAll(receiver);
+    }
+
+    flushingReceivers.removeAll(receiver);
+}
+
+UiFlashState::UiFlashState()
+{
+    pendingFlashing = false;
+    flashLatched = false;
+}
+
+/**
+ * @brief Request the flashing state.
+ * @param Widget that shows the state
+ */
+void UiFlashState::flash(QObject *receiver)
+{
+    pendingFlashing = true;
+    flashLatched = true;
+    UiUpdateBus::getInstance()->scheduleUpdate(receiver);
+}
+
+void UiFlashState::unflash(QObject *receiver)
+{
+    pendingFlashing = false;
+    UiUpdateBus::getInstance()->scheduleUpdate(receiver);
+}
+
+/**
+ * @brief Get the state to show for the current frame. Called from the
+ *     applyFrameUpdate() slot of the widget. A latched press schedules
+ *     another frame for the release.
+ * @param Widget that shows the state
+ * @return Whether the widget should be shown as flashing
+ */
+bool UiFlashState::takeFrameState(QObject *receiver)
+{
+    bool result = pendingFlashing || flashLatched;
+    flashLatched = false;
+
+    if (result != pendingFlashing)
+    {
+        UiUpdateBus::getInstance()->scheduleUpdate(receiver);
+    }
+
+    return result;
+}
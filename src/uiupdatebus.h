@@ -0,0 +1,66 @@
+#ifndef UIUPDATEBUS_H
+#define UIUPDATEBUS_H
+
+#include <QObject>
+#include <QTimer>
+#include <QList>
+#include <QSet>
+
+/**
+ * @brief Coalesce live state updates of widgets to the display refresh rate.
+ *     Widgets that show the state of a controller element record the newest
+ *     state when the element changes and schedule themselves on the bus.
+ *     Once per frame the bus invokes the applyFrameUpdate() slot of every
+ *     scheduled widget, which then repaints from the latest state. A high
+ *     rate controller therefore costs at most one repaint per widget per
+ *     frame. The bus is only used from the GUI thread.
+ */
+class UiUpdateBus : public QObject
+{
+    Q_OBJECT
+public:
+    static UiUpdateBus* getInstance();
+    static void deleteInstance();
+
+    void scheduleUpdate(QObject *receiver);
+
+    static const int FRAMEINTERVAL;
+
+protected:
+    explicit UiUpdateBus(QObject *parent = 0);
+
+    QTimer frameTimer;
+    QList<QObject*> pendingReceivers;
+    QSet<QObject*> pendingLookup;
+    QList<QObject*> flushingReceivers;
+
+    static UiUpdateBus *_instance;
+
+signals:
+
+private slots:
+    void flush();
+    void removeReceiver(QObject *receiver);
+};
+
+/**
+ * @brief Flash state of a widget that shows whether an element is pressed.
+ *     Changes are applied on the next frame of the UI update bus. A press
+ *     that is released again within the same frame is still shown for one
+ *     frame.
+ */
+class UiFlashState
+{
+public:
+    UiFlashState();
+
+    void flash(QObject *receiver);
+    void unflash(QObject *receiver);
+    bool takeFrameState(QObject *receiver);
+
+protected:
+    bool pendingFlashing;
+    bool flashLatched;
+};
+
+#endif // UIUPDATEBUS_H
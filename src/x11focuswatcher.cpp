@@ -0,0 +1,241 @@
+//#include <QDebug>
+
+#include "x11focuswatcher.h"
+#include "x11extras.h"
+
+#include <X11/Xatom.h>
+
+Display* X11FocusWatcher::watcherDisplay = 0;
+XErrorHandler X11FocusWatcher::previousErrorHandler = 0;
+
+X11FocusWatcher::X11FocusWatcher(QObject *parent) :
+    QObject(parent)
+{
+    display = 0;
+    notifier = 0;
+    rootWindow = 0;
+    watchedWindow = 0;
+    activeWindowAtom = None;
+    netWmNameAtom = None;
+    watchTitle = false;
+}
+
+X11FocusWatcher::~X11FocusWatcher()
+{
+    stop();
+}
+
+/**
+ * @brief Open the display connection used for events and start listening.
+ * @param Whether title changes of the active window should be reported
+ * @return Whether events are available. False if the display could not be
+ *     opened or the window manager does not publish the active window.
+ */
+bool X11FocusWatcher::start(bool watchTitle)
+{
+    stop();
+
+    QString displayString = X11Extras::getInstance()->getXDisplayString();
+    QByteArray tempByteArray = displayString.toLocal8Bit();
+    display = XOpenDisplay(!displayString.isEmpty() ? tempByteArray.constData() : NULL);
+    if (display)
+    {
+        rootWindow = XDefaultRootWindow(display);
+        activeWindowAtom = XInternAtom(display, "_NET_ACTIVE_WINDOW", True);
+        netWmNameAtom = XInternAtom(display, "_NET_WM_NAME", True);
+
+        Atom actual_type = None;
+        int actual_format = 0;
+        unsigned long nitems = 0;
+        unsigned long bytes_after = 0;
+        unsigned char *prop = 0;
+        bool supported = false;
+
+        if (activeWindowAtom != None)
+        {
+            int status = XGetWindowProperty(display, rootWindow, activeWindowAtom, 0, 1, False,
+                                            AnyPropertyType, &actual_type, &actual_format,
+                                            &nitems, &bytes_after, &prop);
+            supported = status == Success && actual_type != None;
+        }
+
+        if (prop)
+        {
+            XFree(prop);
+            prop = 0;
+        }
+
+        if (supported)
+        {
+            this->watchTitle = watchTitle;
+
+            // The active window can be destroyed before the watcher stops
+            // listening to it. Errors about it must not end the program.
+            watcherDisplay = display;
+            if (!previousErrorHandler)
+            {
+                previousErrorHandler = XSetErrorHandler(&X11FocusWatcher::handleXError);
+            }
+
+            XSelectInput(display, rootWindow, PropertyChangeMask);
+            updateWatchedWindow();
+
+            // Drop anything Xlib already queued. The caller checks the
+            // current window after starting.
+            while (XPending(display) > 0)
+            {
+                XEvent event;
+                XNextEvent(display, &event);
+            }
+
+            notifier = new QSocketNotifier(ConnectionNumber(display), QSocketNotifier::Read, this);
+            connect(notifier, SIGNAL(activated(int)), this, SLOT(processEvents()));
+        }
+        else
+        {
+            XCloseDisplay(display);
+            display = 0;
+        }
+    }
+
+    return display != 0;
+}
+
+void X11FocusWatcher::stop()
+{
+    if (notifier)
+    {
+        notifier->setEnabled(false);
+        delete notifier;
+        notifier = 0;
+    }
+
+    if (display)
+    {
+        watcherDisplay = 0;
+        XCloseDisplay(display);
+        display = 0;
+    }
+
+    watchedWindow = 0;
+}
+
+bool X11FocusWatcher::isActive()
+{
+    return display != 0;
+}
+
+void X11FocusWatcher::processEvents()
+{
+    bool windowChanged = false;
+    bool titleChanged = false;
+    bool processing = true;
+
+    while (processing)
+    {
+        bool focusChanged = false;
+
+        while (XPending(display) > 0)
+        {
+            XEvent event;
+            XNextEvent(display, &event);
+
+            if (event.type == PropertyNotify)
+            {
+                Window eventWindow = event.xproperty.window;
+                Atom eventAtom = event.xproperty.atom;
+                if (eventWindow == rootWindow && eventAtom == activeWindowAtom)
+                {
+                    focusChanged = true;
+                }
+                else if (eventWindow == watchedWindow &&
+                         (eventAtom == XA_WM_NAME || eventAtom == netWmNameAtom))
+                {
+                    titleChanged = true;
+                }
+            }
+        }
+
+        if (focusChanged)
+        {
+            windowChanged = true;
+            updateWatchedWindow();
+        }
+
+        // Updating the watched window talks to the server and can move
+        // new events into the Xlib queue. The socket notifier does not
+        // fire again for events that were already read.
+        processing = XEventsQueued(display, QueuedAlready) > 0;
+    }
+
+    if (windowChanged || titleChanged)
+    {
+        emit activeWindowChanged();
+    }
+}
+
+Window X11FocusWatcher::getActiveWindow()
+{
+    Window result = 0;
+
+    Atom actual_type = None;
+    int actual_format = 0;
+    unsigned long nitems = 0;
+    unsigned long bytes_after = 0;
+    unsigned char *prop = 0;
+
+    int status = XGetWindowProperty(display, rootWindow, activeWindowAtom, 0, 1, False,
+                                    XA_WINDOW, &actual_type, &actual_format,
+                                    &nitems, &bytes_after, &prop);
+    if (status == Success && prop && nitems > 0 && actual_format == 32)
+    {
+        // Format 32 properties are returned as an array of longs.
+        result = static_cast<Window>(reinterpret_cast<unsigned long*>(prop)[0]);
+    }
+
+    if (prop)
+    {
+        XFree(prop);
+        prop = 0;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Move the title listener to the current active window.
+ */
+void X11FocusWatcher::updateWatchedWindow()
+{
+    Window activeWindow = watchTitle ? getActiveWindow() : 0;
+    if (activeWindow != watchedWindow)
+    {
+        if (watchedWindow)
+        {
+            XSelectInput(display, watchedWindow, NoEventMask);
+        }
+
+        if (activeWindow)
+        {
+            XSelectInput(display, activeWindow, PropertyChangeMask);
+        }
+
+        watchedWindow = activeWindow;
+        XFlush(display);
+    }
+}
+
+int X11FocusWatcher::handleXError(Display *display, XErrorEvent *event)
+{
+    int result = 0;
+
+    // BadWindow errors on the watcher connection come from a watched
+    // window that was destroyed and are ignored.
+    bool watchedWindowError = display == watcherDisplay && event->error_code == BadWindow;
+    if (!watchedWindowError && previousErrorHandler)
+    {
+        result = previousErrorHandler(display, event);
+    }
+
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef X11FOCUSWATCHER_H
+#define X11FOCUSWATCHER_H
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <X11/Xlib.h>
+
+/**
+ * @brief Report changes of the active window through X events instead of
+ *     polling. A separate display connection listens for PropertyNotify
+ *     events of _NET_ACTIVE_WINDOW on the root window and, optionally,
+ *     of the title of the active window. Only usable with a window manager
+ *     that publishes _NET_ACTIVE_WINDOW.
+ */
+class X11FocusWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit X11FocusWatcher(QObject *parent = 0);
+    ~X11FocusWatcher();
+
+    bool start(bool watchTitle);
+    void stop();
+    bool isActive();
+
+protected:
+    Window getActiveWindow();
+    void updateWatchedWindow();
+
+    static int handleXError(Display *display, XErrorEvent *event);
+
+    Display *display;
+    QSocketNotifier *notifier;
+    Window rootWindow;
+    Window watchedWindow;
+    Atom activeWindowAtom;
+    Atom netWmNameAtom;
+    bool watchTitle;
+
+    static Display *watcherDisplay;
+    static XErrorHandler previousErrorHandler;
+
+signals:
+    void activeWindowChanged();
+
+private slots:
+    void processEvents();
+};
+
+#endif // X11FOCUSWATCHER_H